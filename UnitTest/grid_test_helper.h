@@ -0,0 +1,69 @@
+#ifndef GRIDGENERATOR_GRID_TEST_HELPER_H
+#define GRIDGENERATOR_GRID_TEST_HELPER_H
+
+#include <memory>
+#include <mpi.h>
+#include "cartesiangrid_generation.h"
+#include "gtest/gtest.h"
+
+namespace gridtest {
+/// The grids need an initialized MPI environment (single domain).
+class MPIEnvironment : public testing::Environment {
+ public:
+  void SetUp() override {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if(initialized == 0) {
+      MPI_Init(nullptr, nullptr);
+    }
+    MPI::g_mpiInformation.init(0, 1);
+    static std::array<GChar, 9>  name{"UnitTest"};
+    static std::array<GChar*, 1> argv{name.data()};
+    logger.open("unittest_log", true, 1, argv.data(), MPI_COMM_WORLD);
+
+    // timers of the grid generation
+    RESET_TIMERS();
+    NEW_TIMER_GROUP_NOCREATE(TimeKeeper[Timers::AppGroup], "Application");
+    NEW_TIMER_NOCREATE(TimeKeeper[Timers::timertotal], "Total", TimeKeeper[Timers::AppGroup]);
+    NEW_SUB_TIMER_NOCREATE(TimeKeeper[Timers::GridPart], "Partitioning grid generation.", TimeKeeper[Timers::timertotal]);
+    NEW_SUB_TIMER_NOCREATE(TimeKeeper[Timers::GridUniform], "Uniform grid generation.", TimeKeeper[Timers::timertotal]);
+  }
+
+  void TearDown() override {
+    logger.close();
+    MPI_Finalize();
+  }
+};
+
+// registered once for all test files including this header
+[[maybe_unused]] inline testing::Environment* const mpiEnvironment = testing::AddGlobalTestEnvironment(new MPIEnvironment);
+
+template <GInt NDIM>
+using GridGen = CartesianGridGen<Debug_Level::no_debug, NDIM>;
+
+/// Generate the grid of a cube as done by the grid generator, i.e., uniformly refined up to a level and with the boundary
+/// cells refined up to a higher level.
+/// \param uniformLvl Level of the uniform refinement.
+/// \param bndryLvl Level up to which the boundary cells are refined.
+/// \return The generated grid.
+template <GInt NDIM>
+auto generateCubeGrid(const GInt uniformLvl, const GInt bndryLvl) -> std::unique_ptr<GridGen<NDIM>> {
+  auto geometry = std::make_shared<GeometryManager<Debug_Level::no_debug, NDIM>>(MPI_COMM_WORLD);
+  geometry->setup(json{{"cube", {{"type", "cube"}, {"center", std::vector<GDouble>(NDIM, 0.0)}, {"length", 1}}}});
+
+  auto grid = std::make_unique<GridGen<NDIM>>(10000);
+  grid->setGeometryManager(geometry);
+  grid->setBoundingBox(geometry->getBoundingBox());
+  grid->setMaxLvl(bndryLvl);
+  grid->createPartitioningGrid(2);
+  grid->distributePartitioningGrid();
+  grid->uniformRefineGrid(uniformLvl);
+  for(GInt lvl = uniformLvl; lvl < bndryLvl; ++lvl) {
+    grid->refineMarkedCells(grid->markBndryCells(0));
+  }
+  grid->setGlobalIds();
+  return grid;
+}
+} // namespace gridtest
+
+#endif // GRIDGENERATOR_GRID_TEST_HELPER_H
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "algorithm/connected_components.h"
+#include "algorithm/curve_partition.h"
+#include "algorithm/parallel_scan.h"
+#include "algorithm/radix_sort.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+TEST(ExclusiveScan, HandlesZeroInput) {
+  using namespace testing;
+
+  std::vector<GInt> offsets;
+  EXPECT_EQ(algorithm::exclusiveScan(0, [](const GInt /*id*/) { return GInt(1); }, offsets), 0);
+  EXPECT_TRUE(offsets.empty());
+
+  const std::vector<GInt> flags{1, 0, 0, 1, 1, 0, 1};
+  EXPECT_EQ(algorithm::exclusiveScan(flags.size(), [&](const GInt id) { return flags[id]; }, offsets), 4);
+  ASSERT_THAT(offsets, ElementsAre(0, 1, 1, 1, 2, 3, 3));
+}
+
+TEST(ExclusiveScan, MatchesSerialScan) {
+  static constexpr GInt noValues = 100003;
+  std::vector<GInt>     values(noValues);
+  for(GInt id = 0; id < noValues; ++id) {
+    values[id] = (id * 7919) % 13;
+  }
+
+  std::vector<GInt> expected(noValues);
+  std::exclusive_scan(values.begin(), values.end(), expected.begin(), GInt(0));
+
+  std::vector<GInt> offsets;
+  const GInt        total = algorithm::exclusiveScan(noValues, [&](const GInt id) { return values[id]; }, offsets);
+  EXPECT_EQ(total, expected.back() + values.back());
+  EXPECT_EQ(offsets, expected);
+}
+
+TEST(ConnectedComponents, LabelsLine) {
+  using namespace testing;
+
+  // 0-1-2 x 4-5 x 7-8, nodes 3 and 6 are inactive
+  const std::vector<GBool> active{true, true, true, false, true, true, false, true, true};
+  const GInt               noNodes = active.size();
+  std::vector<GInt>        labels;
+
+  const GInt noComponents = algorithm::connectedComponents(
+      noNodes, 2, [&](const GInt id) { return active[id]; },
+      [&](const GInt id, const GInt dir) {
+        const GInt nghbr = dir == 0 ? id - 1 : id + 1;
+        return nghbr < noNodes ? nghbr : -1;
+      },
+      labels);
+  EXPECT_EQ(noComponents, 3);
+  ASSERT_THAT(labels, ElementsAre(0, 0, 0, -1, 4, 4, -1, 7, 7));
+}
+
+TEST(ConnectedComponents, LabelsGrid) {
+  // 2D grid with a wall at x == wallPos separating two regions
+  static constexpr GInt noCellsDir = 257;
+  static constexpr GInt wallPos    = 100;
+  static constexpr GInt noNodes    = noCellsDir * noCellsDir;
+  std::vector<GInt>     labels;
+
+  const auto isActive = [](const GInt id) { return id % noCellsDir != wallPos; };
+  const GInt noComponents = algorithm::connectedComponents(
+      noNodes, 4, isActive,
+      [](const GInt id, const GInt dir) -> GInt {
+        const GInt x = id % noCellsDir;
+        const GInt y = id / noCellsDir;
+        switch(dir) {
+          case 0:
+            return x > 0 ? id - 1 : -1;
+          case 1:
+            return x < noCellsDir - 1 ? id + 1 : -1;
+          case 2:
+            return y > 0 ? id - noCellsDir : -1;
+          default:
+            return y < noCellsDir - 1 ? id + noCellsDir : -1;
+        }
+      },
+      labels);
+  EXPECT_EQ(noComponents, 2);
+  for(GInt id = 0; id < noNodes; ++id) {
+    const GInt x = id % noCellsDir;
+    if(x == wallPos) {
+      EXPECT_EQ(labels[id], -1);
+    } else {
+      EXPECT_EQ(labels[id], x < wallPos ? 0 : wallPos + 1);
+    }
+  }
+}
+
+TEST(RadixSort, HandlesZeroInput) {
+  using namespace testing;
+
+  std::vector<GUint> keys;
+  std::vector<GInt>  values;
+  algorithm::radixSort(keys, values);
+  EXPECT_TRUE(keys.empty());
+
+  keys   = {5, 3, 5, 0, 3};
+  values = {0, 1, 2, 3, 4};
+  algorithm::radixSort(keys, values);
+  ASSERT_THAT(keys, ElementsAre(0, 3, 3, 5, 5));
+  ASSERT_THAT(values, ElementsAre(3, 1, 4, 0, 2));
+}
+
+TEST(RadixSort, MatchesStableSort) {
+  static constexpr GInt noValues = 100003;
+  std::vector<GUint>    keys(noValues);
+  std::vector<GInt>     values(noValues);
+  for(GInt id = 0; id < noValues; ++id) {
+    // only the lower 40 bits are used and the same keys appear multiple times
+    keys[id]   = (static_cast<GUint>(id % 4099) * 0x9E3779B97F4A7C15ULL) & ((1ULL << 40) - 1);
+    values[id] = id;
+  }
+
+  std::vector<GInt> expected(values);
+  std::stable_sort(expected.begin(), expected.end(), [&](const GInt a, const GInt b) { return keys[a] < keys[b]; });
+
+  algorithm::radixSort(keys, values, 40);
+  EXPECT_EQ(values, expected);
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+}
+
+TEST(RadixSort, Handles128BitKeys) {
+  static constexpr GInt noValues = 1000;
+  std::vector<GUint128> keys(noValues);
+  std::vector<GInt>     values(noValues);
+  for(GInt id = 0; id < noValues; ++id) {
+    keys[id]   = (static_cast<GUint128>((noValues - id) % 7) << 100) | static_cast<GUint128>(id);
+    values[id] = id;
+  }
+
+  algorithm::radixSort(keys, values);
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+  for(GInt id = 0; id < noValues; ++id) {
+    EXPECT_EQ(keys[id] & 0xFFFFFFFFU, static_cast<GUint128>(values[id]));
+  }
+}
+
+TEST(PartitionCurve, BalancesUniformWeights) {
+  const std::vector<GDouble> weights(10, 1.0);
+  EXPECT_EQ(algorithm::partitionCurve(weights, 1), std::vector<GInt>({0, 10}));
+  EXPECT_EQ(algorithm::partitionCurve(weights, 2), std::vector<GInt>({0, 5, 10}));
+  EXPECT_EQ(algorithm::partitionCurve(weights, 3), std::vector<GInt>({0, 3, 7, 10}));
+}
+
+TEST(PartitionCurve, HandlesHeavyItems) {
+  const std::vector<GDouble> weights = {1.0, 1.0, 10.0, 1.0, 1.0};
+  EXPECT_EQ(algorithm::partitionCurve(weights, 2), std::vector<GInt>({0, 2, 5}));
+  // more domains than items leaves domains empty
+  EXPECT_EQ(algorithm::partitionCurve(weights, 7), std::vector<GInt>({0, 2, 2, 2, 3, 3, 3, 5}));
+}
+
+TEST(PartitionCurve, MatchesDistributedParts) {
+  std::vector<GDouble> weights(100);
+  for(GInt id = 0; id < 100; ++id) {
+    weights[id] = 1.0 + static_cast<GDouble>(id % 7);
+  }
+  const GInt              noDomains = 6;
+  const std::vector<GInt> expected  = algorithm::partitionCurve(weights, noDomains);
+
+  // split the curve into two parts and sum up the local offsets
+  const GInt        split       = 37;
+  const GDouble     totalWeight = std::accumulate(weights.begin(), weights.end(), 0.0);
+  const GDouble     firstWeight = std::accumulate(weights.begin(), weights.begin() + split, 0.0);
+  std::vector<GInt> first(noDomains + 1);
+  std::vector<GInt> second(noDomains + 1);
+  algorithm::partitionCurve(split, weights.data(), noDomains, first.data(), 0.0, totalWeight);
+  algorithm::partitionCurve(100 - split, weights.data() + split, noDomains, second.data(), firstWeight, totalWeight);
+  for(GInt domainId = 0; domainId <= noDomains; ++domainId) {
+    EXPECT_EQ(first[domainId] + second[domainId], expected[domainId]);
+  }
+}
@@ -0,0 +1,115 @@
+#include <utility>
+#include <vector>
+#include "cell_layout.h"
+#include "common/sfcmm_types.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "util/bit_vector.h"
+
+TEST(BitVector, HandlesZeroInput) {
+  BitVector bits;
+  EXPECT_EQ(bits.size(), 0);
+  EXPECT_EQ(bits.noWords(), 0);
+  EXPECT_EQ(bits.count(), 0);
+
+  bits.resize(1);
+  EXPECT_EQ(bits.noWords(), 1);
+  EXPECT_FALSE(bits[0]);
+  bits[0] = true;
+  EXPECT_TRUE(bits[0]);
+  EXPECT_EQ(bits.count(), 1);
+  bits.reset(0);
+  EXPECT_EQ(bits.count(), 0);
+}
+
+TEST(BitVector, FillsAcrossWords) {
+  BitVector bits(200);
+  bits.fill(3, 190, true);
+  EXPECT_EQ(bits.count(), 187);
+  EXPECT_EQ(bits.count(0, 64), 61);
+  EXPECT_EQ(bits.count(64, 128), 64);
+  EXPECT_FALSE(bits[2]);
+  EXPECT_TRUE(bits[3]);
+  EXPECT_TRUE(bits[189]);
+  EXPECT_FALSE(bits[190]);
+
+  bits.fill(60, 130, false);
+  EXPECT_EQ(bits.count(), 187 - 70);
+  EXPECT_EQ(bits.count(60, 130), 0);
+  EXPECT_TRUE(bits[59]);
+  EXPECT_TRUE(bits[130]);
+}
+
+TEST(BitVector, ResizeKeepsBits) {
+  BitVector bits(70);
+  bits.set(5);
+  bits.set(69);
+  bits.resize(150, true);
+  EXPECT_EQ(bits.size(), 150);
+  EXPECT_EQ(bits.noWords(), 3);
+  EXPECT_EQ(bits.count(0, 70), 2);
+  EXPECT_EQ(bits.count(70, 150), 80);
+
+  bits.resize(10);
+  EXPECT_EQ(bits.count(), 1);
+}
+
+TEST(BitVector, MatchesSerialCount) {
+  static constexpr GInt noBits = 1000;
+  BitVector             a(noBits);
+  BitVector             b(noBits);
+  std::vector<GInt>     expected;
+  GInt                  expectedAndNot = 0;
+  for(GInt id = 0; id < noBits; ++id) {
+    a[id] = (id * 7919) % 3 == 0;
+    b[id] = id % 5 == 0;
+    if(a[id]) {
+      expected.emplace_back(id);
+      expectedAndNot += static_cast<GInt>(!b[id]);
+    }
+  }
+  EXPECT_EQ(a.count(), static_cast<GInt>(expected.size()));
+
+  std::vector<GInt> setBits;
+  bits::forEach(0, noBits, [&](const GInt wordId) { return a.word(wordId); }, [&](const GInt id) { setBits.emplace_back(id); });
+  EXPECT_EQ(setBits, expected);
+
+  EXPECT_EQ(bits::count(0, noBits, [&](const GInt wordId) { return a.word(wordId) & ~b.word(wordId); }), expectedAndNot);
+
+  // partial range within a single word
+  setBits.clear();
+  bits::forEach(130, 140, [&](const GInt wordId) { return a.word(wordId); }, [&](const GInt id) { setBits.emplace_back(id); });
+  for(const GInt id : setBits) {
+    EXPECT_TRUE(id >= 130 && id < 140);
+  }
+  EXPECT_EQ(static_cast<GInt>(setBits.size()), a.count(130, 140));
+}
+
+TEST(CellPropertyStorage, PlanesMatchBitsets) {
+  static constexpr GInt                        noCells = 300;
+  CellPropertyStorage<PropertyStorage::planes> planes;
+  CellPropertyStorage<PropertyStorage::bitset> bitsets;
+  planes.resize(noCells);
+  bitsets.resize(noCells);
+  for(GInt cellId = 0; cellId < noCells; ++cellId) {
+    planes(cellId, CellProperties::bndry)  = cellId % 3 == 0;
+    bitsets(cellId, CellProperties::bndry) = cellId % 3 == 0;
+    planes(cellId, CellProperties::leaf)   = cellId % 4 != 0;
+    bitsets(cellId, CellProperties::leaf)  = cellId % 4 != 0;
+  }
+
+  for(const auto& [begin, end] : std::vector<std::pair<GInt, GInt>>{{0, noCells}, {5, 60}, {63, 129}, {130, 140}}) {
+    EXPECT_EQ(planes.count(CellProperties::bndry, begin, end), bitsets.count(CellProperties::bndry, begin, end));
+    EXPECT_EQ(planes.countAnd(CellProperties::bndry, CellProperties::leaf, begin, end),
+              bitsets.countAnd(CellProperties::bndry, CellProperties::leaf, begin, end));
+    EXPECT_EQ(planes.countAndNot(CellProperties::bndry, CellProperties::leaf, begin, end),
+              bitsets.countAndNot(CellProperties::bndry, CellProperties::leaf, begin, end));
+
+    std::vector<GInt> selectedPlanes;
+    std::vector<GInt> selectedBitsets;
+    planes.forEach(CellProperties::bndry, begin, end, [&](const GInt cellId) { selectedPlanes.emplace_back(cellId); });
+    bitsets.forEach(CellProperties::bndry, begin, end, [&](const GInt cellId) { selectedBitsets.emplace_back(cellId); });
+    EXPECT_EQ(selectedPlanes, selectedBitsets);
+    EXPECT_EQ(static_cast<GInt>(selectedPlanes.size()), planes.count(CellProperties::bndry, begin, end));
+  }
+}
@@ -0,0 +1,38 @@
+#include <numeric>
+#include "common/sfcmm_types.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "util/first_touch.h"
+
+TEST(FirstTouchVector, HandlesZeroInput) {
+  FirstTouchVector<GInt> values;
+  EXPECT_TRUE(values.empty());
+  memory::parallelFill(values, 0, 0, GInt(1));
+  EXPECT_TRUE(values.empty());
+
+  values.resize(10, -1);
+  memory::parallelFill(values, 2, 5, GInt(7));
+  ASSERT_THAT(values, testing::ElementsAre(-1, -1, 7, 7, 7, -1, -1, -1, -1, -1));
+}
+
+TEST(FirstTouchVector, LargeAllocations) {
+  // larger than a huge page, i.e., aligned and touched in parallel
+  static constexpr GInt noValues = 3 * memory::HUGE_PAGE_SIZE / sizeof(GDouble) + 17;
+  memory::setHugePageHint(true);
+  FirstTouchVector<GDouble> values(noValues, 1.0);
+  memory::setHugePageHint(false);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values.data()) % memory::HUGE_PAGE_SIZE, 0);
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0.0), static_cast<GDouble>(noValues));
+
+  memory::parallelFill(values, 0, noValues, 2.0);
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0.0), 2.0 * noValues);
+
+  // the values are kept when the storage grows from a small to a large allocation and back
+  FirstTouchVector<GInt> ids(5);
+  std::iota(ids.begin(), ids.end(), 0);
+  ids.resize(noValues);
+  EXPECT_EQ(ids[4], 4);
+  ids.resize(5);
+  ids.shrink_to_fit();
+  EXPECT_EQ(ids[4], 4);
+}
@@ -0,0 +1,69 @@
+#include "cartesiangrid.h"
+#include "gmock/gmock.h"
+#include "grid_test_helper.h"
+#include "gtest/gtest.h"
+
+namespace {
+static constexpr GInt NDIM = 2;
+using GridGen              = gridtest::GridGen<NDIM>;
+using Grid                 = CartesianGrid<Debug_Level::no_debug, NDIM>;
+
+/// Grids with a wall boundary for the cube.
+class GridHandoff : public testing::Test {
+ protected:
+  void SetUp() override {
+    m_conf.setConfiguration(json{{"solver", {{"boundary", {{"cube", {{"all", {{"type", "wall"}}}}}}}}}});
+    m_config = std::make_shared<ConfigurationAccess>("solver", &m_conf);
+  }
+
+  std::shared_ptr<ConfigurationAccess> m_config;
+
+ private:
+  Configuration m_conf;
+};
+} // namespace
+
+TEST_F(GridHandoff, MovedGridMatchesCopy) {
+  std::unique_ptr<GridInterface> generated = gridtest::generateCubeGrid<NDIM>(4, 6);
+  const auto&                    generator = static_cast<const GridGen&>(*generated);
+  ASSERT_GT(generator.noCells(), 0);
+
+  Grid copied;
+  copied.loadGridInplace(generator, m_config);
+
+  Grid moved;
+  moved.loadGrid(std::move(generated), m_config);
+  EXPECT_EQ(generated, nullptr);
+
+  ASSERT_EQ(moved.noCells(), copied.noCells());
+  EXPECT_EQ(moved.noLeafCells(), copied.noLeafCells());
+  EXPECT_EQ(moved.noBndCells(), copied.noBndCells());
+  for(GInt cellId = 0; cellId < copied.noCells(); ++cellId) {
+    EXPECT_EQ(moved.parent(cellId), copied.parent(cellId));
+    EXPECT_EQ(moved.level(cellId), copied.level(cellId));
+    EXPECT_EQ(moved.globalId(cellId), copied.globalId(cellId));
+    EXPECT_EQ(moved.center(cellId), copied.center(cellId));
+    for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
+      EXPECT_EQ(moved.child(cellId, childId), copied.child(cellId, childId));
+    }
+    for(GInt dir = 0; dir < cartesian::maxNoNghbrsDiag<NDIM>(); ++dir) {
+      EXPECT_EQ(moved.neighbor(cellId, dir), copied.neighbor(cellId, dir));
+    }
+    for(GInt prop = 0; prop < grid::cell::p(CellProperties::NumProperties); ++prop) {
+      EXPECT_EQ(moved.property(cellId, static_cast<CellProperties>(prop)), copied.property(cellId, static_cast<CellProperties>(prop)));
+    }
+  }
+  EXPECT_EQ(moved.bndrySurface("cube").size(), copied.bndrySurface("cube").size());
+}
+
+TEST_F(GridHandoff, MovedGeneratorIsEmpty) {
+  auto       generator = gridtest::generateCubeGrid<NDIM>(4, 6);
+  const GInt noCells   = generator->noCells();
+
+  Grid moved;
+  moved.loadGrid(std::move(*generator), m_config);
+  EXPECT_EQ(moved.noCells(), noCells);
+  EXPECT_TRUE(generator->empty());
+  EXPECT_EQ(generator->capacity(), 0);
+  EXPECT_EQ(generator->noCells(), 0);
+}
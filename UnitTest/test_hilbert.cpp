@@ -218,3 +218,69 @@ TEST(HilbertIndex4D, HandlesZeroInput) {
   EXPECT_EQ(hilbert::index<4>(quadrantP, 1), 5);
   EXPECT_EQ(hilbert::index<4>(quadrantP, 2), 94);
 }
+
+TEST(HilbertKey2D, HandlesZeroInput) {
+  EXPECT_EQ(hilbert::encode<2>({0, 0}, 0), 0);
+  EXPECT_EQ(hilbert::encode<2>({0, 0}, 1), 0);
+  EXPECT_EQ(hilbert::encode<2>({0, 1}, 1), 1);
+  EXPECT_EQ(hilbert::encode<2>({1, 1}, 1), 2);
+  EXPECT_EQ(hilbert::encode<2>({1, 0}, 1), 3);
+
+  // the curve starts and ends in the corners of the domain
+  EXPECT_EQ(hilbert::encode<2>({0, 0}, 4), 0);
+  EXPECT_EQ(hilbert::encode<2>({15, 0}, 4), 255);
+}
+
+template <GInt NDIM>
+void checkHilbertCurve(const GInt bits) {
+  const GUint noKeys = GUint(1) << (NDIM * bits);
+  auto        prev   = hilbert::decode<NDIM>(GUint(0), bits);
+  for(GUint key = 0; key < noKeys; ++key) {
+    const auto x = hilbert::decode<NDIM>(key, bits);
+    ASSERT_EQ(hilbert::encode<NDIM>(x, bits), key);
+
+    // consecutive keys are face neighbors
+    GInt distance = 0;
+    for(GInt dir = 0; dir < NDIM; ++dir) {
+      distance += std::abs(static_cast<GInt>(x[dir]) - static_cast<GInt>(prev[dir]));
+    }
+    ASSERT_EQ(distance, key == 0 ? 0 : 1);
+    prev = x;
+  }
+}
+
+TEST(HilbertKey, IsContinuous) {
+  checkHilbertCurve<1>(5);
+  checkHilbertCurve<2>(4);
+  checkHilbertCurve<3>(3);
+  checkHilbertCurve<4>(2);
+}
+
+TEST(HilbertKey, BatchMatchesScalar) {
+  static constexpr GInt noPoints = 1000;
+  static constexpr GInt bits     = 10;
+
+  std::vector<hilbert::Coordinate<3>> x(noPoints);
+  for(GInt id = 0; id < noPoints; ++id) {
+    x[id] = {static_cast<GUint32>((id * 7919) % 1024), static_cast<GUint32>((id * 104729) % 1024), static_cast<GUint32>((id * 31) % 1024)};
+  }
+
+  std::vector<GUint> keys(noPoints);
+  hilbert::encode<3>(noPoints, x.data(), bits, keys.data());
+  for(GInt id = 0; id < noPoints; ++id) {
+    EXPECT_EQ(keys[id], hilbert::encode<3>(x[id], bits));
+  }
+}
+
+TEST(HilbertKey, Handles128Bit) {
+  const hilbert::Coordinate<3> x{123456, 654321, 1U << 20U};
+  EXPECT_TRUE((hilbert::encode<3, GUint128>(x, 21) == hilbert::encode<3>(x, 21)));
+
+  const hilbert::Coordinate<4> y{4000000000U, 123, 3000000000U, 77777777U};
+  const auto                   key = hilbert::encode<4, GUint128>(y, 32);
+  EXPECT_EQ((hilbert::decode<4, GUint128>(key, 32)), y);
+
+  std::array<GUint128, 1> keys{};
+  hilbert::encode<4, GUint128>(1, &y, 32, keys.data());
+  EXPECT_TRUE(keys[0] == key);
+}
@@ -0,0 +1,38 @@
+#include <iomanip>
+#include <sstream>
+#include "gmock/gmock.h"
+#include "grid_test_helper.h"
+#include "gtest/gtest.h"
+
+namespace {
+static constexpr GInt NDIM = 2;
+} // namespace
+
+TEST(RefinementRegion, ExpressionCannotPrune) {
+  const RegionBox<NDIM>        box(Point<NDIM>(0.0, 0.0), Point<NDIM>(1.0, 1.0), 5);
+  const RegionExpression<NDIM> expression("x > y", 5);
+  EXPECT_TRUE(box.canPrune());
+  EXPECT_FALSE(expression.canPrune());
+}
+
+TEST(RefinementRegion, MarksSmallExpressionRegion) {
+  static constexpr GInt uniformLvl = 4;
+  auto                  grid       = gridtest::generateCubeGrid<NDIM>(uniformLvl, uniformLvl);
+  ASSERT_EQ(grid->currentHighestLvl(), uniformLvl);
+
+  // circle around the center of a cell of the highest level, which contains none of the sample points of the coarser
+  // cells, i.e., it is only found by checking the cells of the highest level
+  GInt cellId = 0;
+  while(std::to_integer<GInt>(grid->level(cellId)) != uniformLvl) {
+    ++cellId;
+  }
+  const Point<NDIM> x      = grid->center(cellId);
+  const GDouble     radius = 0.25 * grid->lengthOnLvl(uniformLvl);
+  std::ostringstream expression;
+  expression << std::setprecision(17) << "(x - " << x[0] << ")^2 + (y - " << x[1] << ")^2 < " << radius * radius;
+
+  std::vector<std::unique_ptr<RefinementRegion<NDIM>>> regions;
+  regions.emplace_back(std::make_unique<RegionExpression<NDIM>>(expression.str(), uniformLvl + 1));
+  EXPECT_EQ(grid->markRegionCells(regions), 1);
+  EXPECT_TRUE(grid->property(cellId, CellProperties::toRefine));
+}
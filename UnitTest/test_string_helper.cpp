@@ -1,7 +1,7 @@
 #include <array>
 #include <cstddef>
 #include <vector>
-#include "common/types.h"
+#include "common/sfcmm_types.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "util/string_helper.h"
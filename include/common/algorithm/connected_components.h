@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef SFCMM_CONNECTED_COMPONENTS_H
+#define SFCMM_CONNECTED_COMPONENTS_H
+#include <atomic>
+#include <vector>
+#include "common/sfcmm_types.h"
+
+namespace algorithm {
+namespace detail {
+/// Find the root of the given node and halve the path on the way. Concurrent path halving is safe since a node only
+/// ever gets linked to one of its ancestors.
+/// \param parent Parent of each node.
+/// \param node Node of which the root is searched.
+/// \return The root of the node.
+inline auto findRoot(std::vector<std::atomic<GInt>>& parent, GInt node) -> GInt {
+  GInt next = parent[node].load(std::memory_order_relaxed);
+  while(next != node) {
+    const GInt grandParent = parent[next].load(std::memory_order_relaxed);
+    if(grandParent != next) {
+      parent[node].compare_exchange_weak(next, grandParent, std::memory_order_relaxed);
+    }
+    node = next;
+    next = parent[node].load(std::memory_order_relaxed);
+  }
+  return node;
+}
+
+/// Merge the trees of the two nodes. The root with the higher index is always linked to the root with the lower index,
+/// i.e., the root of a tree is always its smallest node.
+/// \param parent Parent of each node.
+/// \param a First node.
+/// \param b Second node.
+inline void unite(std::vector<std::atomic<GInt>>& parent, GInt a, GInt b) {
+  while(true) {
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if(a == b) {
+      return;
+    }
+    if(a < b) {
+      std::swap(a, b);
+    }
+    // only succeeds if a is still a root, otherwise retry with the new roots
+    GInt expected = a;
+    if(parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+} // namespace detail
+
+/// Label the connected components of a graph in parallel with a lock-free union-find.
+/// Only active nodes take part and an edge connects two nodes if both of them are active. Each active node is labelled
+/// with the smallest node index of its component, which makes the result independent of the number of threads.
+/// \tparam ActiveFunctor Callable returning if a node is active.
+/// \tparam EdgeFunctor Callable returning the neighbor of a node in the given direction (or a negative value if none).
+/// \param noNodes Number of nodes.
+/// \param maxNoEdges Maximum number of edges per node.
+/// \param active Functor returning if the node is active.
+/// \param edge Functor returning the neighbor of the node for the given edge index.
+/// \param labels Label of each node (resized to noNodes). Inactive nodes are labelled with -1.
+/// \return Number of connected components.
+template <class ActiveFunctor, class EdgeFunctor>
+inline auto connectedComponents(const GInt noNodes, const GInt maxNoEdges, ActiveFunctor&& active, EdgeFunctor&& edge,
+                                std::vector<GInt>& labels) -> GInt {
+  labels.resize(noNodes);
+  if(noNodes <= 0) {
+    return 0;
+  }
+
+  std::vector<std::atomic<GInt>> parent(noNodes);
+  GInt                           noComponents = 0;
+#ifdef _OPENMP
+#pragma omp parallel default(none) shared(noNodes, maxNoEdges, active, edge, labels, parent, noComponents)
+#endif
+  {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for(GInt node = 0; node < noNodes; ++node) {
+      parent[node].store(node, std::memory_order_relaxed);
+    }
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+    for(GInt node = 0; node < noNodes; ++node) {
+      if(!active(node)) {
+        continue;
+      }
+      for(GInt edgeId = 0; edgeId < maxNoEdges; ++edgeId) {
+        const GInt nghbr = edge(node, edgeId);
+        if(nghbr >= 0 && nghbr != node && active(nghbr)) {
+          detail::unite(parent, node, nghbr);
+        }
+      }
+    }
+
+#ifdef _OPENMP
+#pragma omp for schedule(static) reduction(+ : noComponents)
+#endif
+    for(GInt node = 0; node < noNodes; ++node) {
+      if(!active(node)) {
+        labels[node] = -1;
+        continue;
+      }
+      labels[node] = detail::findRoot(parent, node);
+      if(labels[node] == node) {
+        ++noComponents;
+      }
+    }
+  }
+  return noComponents;
+}
+} // namespace algorithm
+
+#endif // SFCMM_CONNECTED_COMPONENTS_H
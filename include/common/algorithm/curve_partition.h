@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef SFCMM_CURVE_PARTITION_H
+#define SFCMM_CURVE_PARTITION_H
+#include <algorithm>
+#include <vector>
+#include "common/algorithm/parallel_scan.h"
+#include "common/sfcmm_types.h"
+
+namespace algorithm {
+/// Cut a curve of weighted items into consecutive ranges of approximately equal weight. Each item belongs to the domain
+/// in which the center of its weight is located, i.e., the imbalance is at most the weight of the heaviest item. The
+/// items might be a part of a larger curve that is distributed, in which case the range of the domains is limited to the
+/// local items and the global offsets are given by the sum of the offsets of all parts.
+/// \tparam T Type of the weights.
+/// \param noItems Number of (local) items.
+/// \param weights Weight of each item.
+/// \param noDomains Number of domains.
+/// \param offsets First (local) item of each domain (noDomains + 1 entries).
+/// \param weightOffset Weight of the items in front of the local items.
+/// \param totalWeight Weight of all items (the sum of the local weights if negative).
+template <typename T>
+inline void partitionCurve(const GInt noItems, const T* weights, const GInt noDomains, GInt* offsets, const T weightOffset = T(0),
+                           T totalWeight = T(-1)) {
+  std::vector<T> centers;
+  const T        localWeight = exclusiveScan(noItems, [&](const GInt id) { return weights[id]; }, centers);
+  if(totalWeight < T(0)) {
+    totalWeight = weightOffset + localWeight;
+  }
+  for(GInt id = 0; id < noItems; ++id) {
+    centers[id] += weightOffset + weights[id] / T(2);
+  }
+
+  offsets[0] = 0;
+  for(GInt domainId = 1; domainId < noDomains; ++domainId) {
+    const T firstWeight = totalWeight * static_cast<T>(domainId) / static_cast<T>(noDomains);
+    offsets[domainId]   = std::lower_bound(centers.begin(), centers.end(), firstWeight) - centers.begin();
+  }
+  offsets[noDomains] = noItems;
+}
+
+/// Cut a curve of weighted items into consecutive ranges of approximately equal weight.
+/// \tparam T Type of the weights.
+/// \param weights Weight of each item.
+/// \param noDomains Number of domains.
+/// \return First item of each domain (noDomains + 1 entries).
+template <typename T>
+inline auto partitionCurve(const std::vector<T>& weights, const GInt noDomains) -> std::vector<GInt> {
+  std::vector<GInt> offsets(noDomains + 1);
+  partitionCurve(static_cast<GInt>(weights.size()), weights.data(), noDomains, offsets.data());
+  return offsets;
+}
+} // namespace algorithm
+
+#endif // SFCMM_CURVE_PARTITION_H
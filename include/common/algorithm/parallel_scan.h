@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef SFCMM_PARALLEL_SCAN_H
+#define SFCMM_PARALLEL_SCAN_H
+#include <vector>
+#include "common/sfcmm_types.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace algorithm {
+/// Calculate the exclusive prefix sum of the values returned by the functor in parallel.
+/// Each thread sums up its static chunk, the chunk sums are scanned serially and then each thread writes the offsets for its
+/// chunk. The result is identical to the serial scan independent of the number of threads.
+/// \tparam T Type of the values to be summed up.
+/// \tparam Functor Callable returning the value for a given index.
+/// \param noValues Number of values.
+/// \param value Functor returning the value at the given index.
+/// \param offsets Pointer to the storage of the exclusive prefix sum of size noValues.
+/// \return The total sum of all values.
+template <typename T, class Functor>
+inline auto exclusiveScan(const GInt noValues, Functor&& value, T* offsets) -> T {
+  if(noValues <= 0) {
+    return T(0);
+  }
+#ifdef _OPENMP
+  std::vector<T> chunkSum(omp_get_max_threads() + 1, T(0));
+#pragma omp parallel default(none) shared(noValues, value, offsets, chunkSum)
+  {
+    const GInt threadId = omp_get_thread_num();
+    T          localSum = T(0);
+#pragma omp for schedule(static)
+    for(GInt id = 0; id < noValues; ++id) {
+      offsets[id] = localSum;
+      localSum += value(id);
+    }
+    chunkSum[threadId + 1] = localSum;
+#pragma omp barrier
+#pragma omp single
+    {
+      for(GUint chunkId = 1; chunkId < chunkSum.size(); ++chunkId) {
+        chunkSum[chunkId] += chunkSum[chunkId - 1];
+      }
+    }
+    // the static schedule distributes identical chunks for the same loop bounds
+    const T chunkOffset = chunkSum[threadId];
+#pragma omp for schedule(static)
+    for(GInt id = 0; id < noValues; ++id) {
+      offsets[id] += chunkOffset;
+    }
+  }
+  return chunkSum.back();
+#else
+  T sum = T(0);
+  for(GInt id = 0; id < noValues; ++id) {
+    offsets[id] = sum;
+    sum += value(id);
+  }
+  return sum;
+#endif
+}
+
+/// Calculate the exclusive prefix sum of the values returned by the functor in parallel.
+/// \tparam T Type of the values to be summed up.
+/// \tparam Functor Callable returning the value for a given index.
+/// \param noValues Number of values.
+/// \param value Functor returning the value at the given index.
+/// \param offsets Vector storing the exclusive prefix sum (resized to noValues).
+/// \return The total sum of all values.
+template <typename T, class Functor>
+inline auto exclusiveScan(const GInt noValues, Functor&& value, std::vector<T>& offsets) -> T {
+  offsets.resize(noValues);
+  return exclusiveScan(noValues, std::forward<Functor>(value), offsets.data());
+}
+} // namespace algorithm
+
+#endif // SFCMM_PARALLEL_SCAN_H
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef SFCMM_RADIX_SORT_H
+#define SFCMM_RADIX_SORT_H
+#include <algorithm>
+#include <climits>
+#include <utility>
+#include <vector>
+#include "common/sfcmm_types.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace algorithm {
+/// Sort the values by their (non-negative) keys in parallel with a stable least significant digit radix sort.
+/// Each pass handles one byte of the key: every thread counts the digits of its static chunk, the counts are scanned
+/// bucket-major/thread-minor and every thread scatters its chunk to the resulting positions. Passes in which all keys have
+/// the same digit are skipped. The result is identical to a stable serial sort independent of the number of threads.
+/// \tparam KeyType Integral type of the keys (e.g. GUint, GInt or GUint128).
+/// \tparam ValueType Type of the values that are sorted along with the keys.
+/// \param noValues Number of values.
+/// \param keys Keys of the values which are sorted in place.
+/// \param values Values which are reordered in place according to the keys.
+/// \param keyBuffer Scratch storage for noValues keys.
+/// \param valueBuffer Scratch storage for noValues values.
+/// \param noKeyBits Number of significant (lower) bits of the keys.
+template <typename KeyType, typename ValueType>
+inline void radixSort(const GInt noValues, KeyType* keys, ValueType* values, KeyType* keyBuffer, ValueType* valueBuffer,
+                      const GInt noKeyBits) {
+  static constexpr GInt radixBits = 8;
+  static constexpr GInt noBuckets = 1 << radixBits;
+  if(noValues <= 1) {
+    return;
+  }
+
+#ifdef _OPENMP
+  const GInt noThreads = omp_get_max_threads();
+#else
+  const GInt noThreads = 1;
+#endif
+  std::vector<GInt> offsets(noThreads * noBuckets);
+  KeyType*          srcKeys   = keys;
+  ValueType*        srcValues = values;
+  KeyType*          dstKeys   = keyBuffer;
+  ValueType*        dstValues = valueBuffer;
+
+  for(GInt shift = 0; shift < noKeyBits; shift += radixBits) {
+    std::fill(offsets.begin(), offsets.end(), 0);
+    GBool skipPass = false;
+#ifdef _OPENMP
+#pragma omp parallel default(none) shared(noValues, noThreads, offsets, shift, skipPass, srcKeys, srcValues, dstKeys, dstValues)
+#endif
+    {
+#ifdef _OPENMP
+      const GInt threadId = omp_get_thread_num();
+#else
+      const GInt threadId = 0;
+#endif
+      GInt* histogram = &offsets[threadId * noBuckets];
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+      for(GInt id = 0; id < noValues; ++id) {
+        ++histogram[static_cast<GInt>((srcKeys[id] >> shift) & (noBuckets - 1))];
+      }
+
+#ifdef _OPENMP
+#pragma omp single
+#endif
+      {
+        GInt offset = 0;
+        for(GInt bucket = 0; bucket < noBuckets; ++bucket) {
+          GInt noValuesBucket = 0;
+          for(GInt chunkId = 0; chunkId < noThreads; ++chunkId) {
+            const GInt count                      = offsets[chunkId * noBuckets + bucket];
+            offsets[chunkId * noBuckets + bucket] = offset;
+            offset += count;
+            noValuesBucket += count;
+          }
+          skipPass = skipPass || noValuesBucket == noValues;
+        }
+      }
+
+      // the static schedule distributes identical chunks for the same loop bounds which keeps the sort stable
+      if(!skipPass) {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(GInt id = 0; id < noValues; ++id) {
+          const GInt pos = histogram[static_cast<GInt>((srcKeys[id] >> shift) & (noBuckets - 1))]++;
+          dstKeys[pos]   = srcKeys[id];
+          dstValues[pos] = std::move(srcValues[id]);
+        }
+      }
+    }
+    if(!skipPass) {
+      std::swap(srcKeys, dstKeys);
+      std::swap(srcValues, dstValues);
+    }
+  }
+
+  if(srcKeys != keys) {
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(noValues, keys, values, srcKeys, srcValues)
+#endif
+    for(GInt id = 0; id < noValues; ++id) {
+      keys[id]   = srcKeys[id];
+      values[id] = std::move(srcValues[id]);
+    }
+  }
+}
+
+/// Sort the values by their (non-negative) keys in parallel with a stable least significant digit radix sort.
+/// \tparam KeyType Integral type of the keys (e.g. GUint, GInt or GUint128).
+/// \tparam ValueType Type of the values that are sorted along with the keys.
+/// \param keys Keys of the values which are sorted in place.
+/// \param values Values which are reordered in place according to the keys (same size as keys).
+/// \param noKeyBits Number of significant (lower) bits of the keys.
+template <typename KeyType, typename ValueType>
+inline void radixSort(std::vector<KeyType>& keys, std::vector<ValueType>& values,
+                      const GInt noKeyBits = CHAR_BIT * sizeof(KeyType)) {
+  std::vector<KeyType>   keyBuffer(keys.size());
+  std::vector<ValueType> valueBuffer(values.size());
+  radixSort(static_cast<GInt>(keys.size()), keys.data(), values.data(), keyBuffer.data(), valueBuffer.data(), noKeyBits);
+}
+} // namespace algorithm
+
+#endif // SFCMM_RADIX_SORT_H
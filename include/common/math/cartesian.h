@@ -103,7 +103,7 @@ static constexpr std::array<std::array<GDouble, sfcmm::MAX_DIM>, cartesian::maxN
 // todo: replace with constant expression function
 /// Given the childId gives the neighboring childIds(and existence ==-1 ->
 /// doesnot exist)
-static constexpr std::array<std::array<GDouble, cartesian::maxNoNghbrs<sfcmm::MAX_DIM>()>, cartesian::maxNoChildren<sfcmm::MAX_DIM>()>
+static constexpr std::array<std::array<GInt, cartesian::maxNoNghbrs<sfcmm::MAX_DIM>()>, cartesian::maxNoChildren<sfcmm::MAX_DIM>()>
     nghbrInside = {{
         //-x +x -y +y -z +z -zz +zz
         {{-1, 1, -1, 2, -1, 4, -1, 8}},  // 0
@@ -129,7 +129,7 @@ static constexpr std::array<std::array<GDouble, cartesian::maxNoNghbrs<sfcmm::MA
 // todo: replace with constant expression function
 /// Given the childId obtain the possible neighbors in a neighboring cell that
 /// doesnot have the same parent
-static constexpr std::array<std::array<GDouble, cartesian::maxNoNghbrs<sfcmm::MAX_DIM>()>, cartesian::maxNoChildren<sfcmm::MAX_DIM>()>
+static constexpr std::array<std::array<GInt, cartesian::maxNoNghbrs<sfcmm::MAX_DIM>()>, cartesian::maxNoChildren<sfcmm::MAX_DIM>()>
     nghbrParentChildId = {{
         //-x +x -y +y -z +z -zz +zz
         {{1, -1, 2, -1, 4, -1, 8, -1}},  // 0
@@ -3,6 +3,8 @@
 #ifndef SFCMM_HILBERT_H
 #define SFCMM_HILBERT_H
 #include "common/sfcmm_types.h"
+#include <algorithm>
+#include <array>
 #include <bitset>
 #include <gcem.hpp>
 
@@ -46,5 +48,229 @@ inline auto index(const VectorD<NDIM> &x, const GInt hilbertLevel) -> GInt {
   }
   return index;
 }
+
+/// Integer coordinates on a uniform grid with 2^bits cells in each direction.
+template <GInt NDIM>
+using Coordinate = std::array<GUint32, NDIM>;
+
+/// Transform integer coordinates into the transposed Hilbert index (in place) following J. Skilling, "Programming the
+/// Hilbert curve", AIP Conference Proceedings 707, 2004.
+/// \tparam NDIM Dimension of the coordinates.
+/// \param x Coordinates (< 2^bits) which are replaced by the transposed Hilbert index.
+/// \param bits Number of bits per coordinate, i.e. the number of iterations of the Hilbert curve (1-32).
+template <GInt NDIM>
+inline void axesToTranspose(Coordinate<NDIM>& x, const GInt bits) {
+  const GUint32 highestBit = GUint32(1) << (bits - 1);
+  // inverse undo
+  for(GUint32 q = highestBit; q > 1; q >>= 1) {
+    const GUint32 p = q - 1;
+    for(GInt dir = 0; dir < NDIM; ++dir) {
+      if((x[dir] & q) != 0) {
+        // invert
+        x[0] ^= p;
+      } else {
+        // exchange
+        const GUint32 t = (x[0] ^ x[dir]) & p;
+        x[0] ^= t;
+        x[dir] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for(GInt dir = 1; dir < NDIM; ++dir) {
+    x[dir] ^= x[dir - 1];
+  }
+  GUint32 t = 0;
+  for(GUint32 q = highestBit; q > 1; q >>= 1) {
+    if((x[NDIM - 1] & q) != 0) {
+      t ^= q - 1;
+    }
+  }
+  for(GInt dir = 0; dir < NDIM; ++dir) {
+    x[dir] ^= t;
+  }
+}
+
+/// Transform the transposed Hilbert index back into integer coordinates (in place), inverse of axesToTranspose().
+/// \tparam NDIM Dimension of the coordinates.
+/// \param x Transposed Hilbert index which is replaced by the coordinates.
+/// \param bits Number of bits per coordinate (1-32).
+template <GInt NDIM>
+inline void transposeToAxes(Coordinate<NDIM>& x, const GInt bits) {
+  const GUint noCellsDir = GUint(1) << bits;
+
+  // Gray decode
+  GUint32 t = x[NDIM - 1] >> 1;
+  for(GInt dir = NDIM - 1; dir > 0; --dir) {
+    x[dir] ^= x[dir - 1];
+  }
+  x[0] ^= t;
+
+  // undo excess work
+  for(GUint q = 2; q != noCellsDir; q <<= 1) {
+    const auto p = static_cast<GUint32>(q - 1);
+    for(GInt dir = NDIM - 1; dir >= 0; --dir) {
+      if((x[dir] & q) != 0) {
+        x[0] ^= p;
+      } else {
+        t = (x[0] ^ x[dir]) & p;
+        x[0] ^= t;
+        x[dir] ^= t;
+      }
+    }
+  }
+}
+
+/// Lookup table to insert NDIM - 1 zero bits between the bits of a byte.
+/// \tparam NDIM Dimension of the coordinates.
+/// \return Spread bits of all byte values.
+template <GInt NDIM>
+constexpr auto spreadBits() -> std::array<GUint, 256> {
+  std::array<GUint, 256> lut{};
+  for(GUint value = 0; value < lut.size(); ++value) {
+    for(GUint bit = 0; bit < 8; ++bit) {
+      lut[value] |= ((value >> bit) & 1U) << (bit * NDIM);
+    }
+  }
+  return lut;
+}
+
+/// Interleave the bits of the transposed Hilbert index into a single key.
+/// \tparam NDIM Dimension of the coordinates.
+/// \tparam KeyType Unsigned integer type of the key with at least NDIM * bits bits.
+/// \param x Transposed Hilbert index.
+/// \param bits Number of bits per coordinate.
+/// \return The Hilbert key.
+template <GInt NDIM, typename KeyType>
+inline auto interleave(const Coordinate<NDIM>& x, const GInt bits) -> KeyType {
+  static constexpr std::array<GUint, 256> spread = spreadBits<NDIM>();
+  KeyType                                 key    = 0;
+  for(GInt dir = 0; dir < NDIM; ++dir) {
+    KeyType spreadDir = 0;
+    for(GInt byte = 0; 8 * byte < bits; ++byte) {
+      spreadDir |= static_cast<KeyType>(spread[(x[dir] >> (8 * byte)) & 0xFFU]) << (8 * byte * NDIM);
+    }
+    key |= spreadDir << (NDIM - 1 - dir);
+  }
+  return key;
+}
+
+/// Calculate the Hilbert key of integer coordinates.
+/// \tparam NDIM Dimension of the coordinates.
+/// \tparam KeyType Unsigned integer type of the key with at least NDIM * bits bits (e.g. GUint or GUint128).
+/// \param x Coordinates (< 2^bits).
+/// \param bits Number of iterations of the Hilbert curve (0-32).
+/// \return The Hilbert key.
+template <GInt NDIM, typename KeyType = GUint>
+inline auto encode(Coordinate<NDIM> x, const GInt bits) -> KeyType {
+  static_assert(NDIM > 0, "Invalid dimension!");
+  if(bits == 0) {
+    return 0;
+  }
+  axesToTranspose<NDIM>(x, bits);
+  return interleave<NDIM, KeyType>(x, bits);
+}
+
+/// Calculate the integer coordinates from a Hilbert key, inverse of encode().
+/// \tparam NDIM Dimension of the coordinates.
+/// \tparam KeyType Unsigned integer type of the key.
+/// \param key The Hilbert key.
+/// \param bits Number of iterations of the Hilbert curve (0-32).
+/// \return The coordinates.
+template <GInt NDIM, typename KeyType = GUint>
+inline auto decode(const KeyType key, const GInt bits) -> Coordinate<NDIM> {
+  Coordinate<NDIM> x{};
+  if(bits == 0) {
+    return x;
+  }
+  for(GInt bit = bits - 1; bit >= 0; --bit) {
+    for(GInt dir = 0; dir < NDIM; ++dir) {
+      const GInt pos = bit * NDIM + NDIM - 1 - dir;
+      x[dir] |= static_cast<GUint32>((key >> pos) & 1U) << bit;
+    }
+  }
+  transposeToAxes<NDIM>(x, bits);
+  return x;
+}
+
+/// Calculate the Hilbert keys for an array of integer coordinates. The coordinates are processed in blocks stored as
+/// structure of arrays with a branch-free version of the transformation, which allows vectorization.
+/// \tparam NDIM Dimension of the coordinates.
+/// \tparam KeyType Unsigned integer type of the key with at least NDIM * bits bits (e.g. GUint or GUint128).
+/// \param noPoints Number of coordinates.
+/// \param coordinates Coordinates (< 2^bits).
+/// \param bits Number of iterations of the Hilbert curve (0-32).
+/// \param keys Storage for the noPoints Hilbert keys.
+template <GInt NDIM, typename KeyType = GUint>
+inline void encode(const GInt noPoints, const Coordinate<NDIM>* coordinates, const GInt bits, KeyType* keys) {
+  static constexpr GInt blockSize = 256;
+  if(bits == 0) {
+    std::fill(keys, keys + noPoints, KeyType(0));
+    return;
+  }
+
+  const GUint32                                    highestBit = GUint32(1) << (bits - 1);
+  std::array<std::array<GUint32, blockSize>, NDIM> x;
+  std::array<GUint32, blockSize>                   gray;
+  for(GInt begin = 0; begin < noPoints; begin += blockSize) {
+    const GInt noBlockPoints = std::min(blockSize, noPoints - begin);
+    for(GInt id = 0; id < noBlockPoints; ++id) {
+      for(GInt dir = 0; dir < NDIM; ++dir) {
+        x[dir][id] = coordinates[begin + id][dir];
+      }
+    }
+
+    // inverse undo
+    for(GUint32 q = highestBit; q > 1; q >>= 1) {
+      const GUint32 p = q - 1;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for(GInt id = 0; id < noBlockPoints; ++id) {
+        x[0][id] ^= p & (GUint32(0) - static_cast<GUint32>((x[0][id] & q) != 0));
+      }
+      for(GInt dir = 1; dir < NDIM; ++dir) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for(GInt id = 0; id < noBlockPoints; ++id) {
+          // either invert or exchange
+          const GUint32 invert = GUint32(0) - static_cast<GUint32>((x[dir][id] & q) != 0);
+          const GUint32 t      = (x[0][id] ^ x[dir][id]) & p & ~invert;
+          x[0][id] ^= (p & invert) ^ t;
+          x[dir][id] ^= t;
+        }
+      }
+    }
+
+    // Gray encode
+    for(GInt dir = 1; dir < NDIM; ++dir) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for(GInt id = 0; id < noBlockPoints; ++id) {
+        x[dir][id] ^= x[dir - 1][id];
+      }
+    }
+    std::fill(gray.begin(), gray.end(), 0);
+    for(GUint32 q = highestBit; q > 1; q >>= 1) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for(GInt id = 0; id < noBlockPoints; ++id) {
+        gray[id] ^= (q - 1) & (GUint32(0) - static_cast<GUint32>((x[NDIM - 1][id] & q) != 0));
+      }
+    }
+
+    for(GInt id = 0; id < noBlockPoints; ++id) {
+      Coordinate<NDIM> transpose;
+      for(GInt dir = 0; dir < NDIM; ++dir) {
+        transpose[dir] = x[dir][id] ^ gray[id];
+      }
+      keys[begin + id] = interleave<NDIM, KeyType>(transpose, bits);
+    }
+  }
+}
 } // namespace hilbert
 #endif // SFCMM_HILBERT_H
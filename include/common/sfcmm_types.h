@@ -40,6 +40,8 @@ using GInt32  = int32_t;
 using GUint32 = uint32_t;
 using GInt    = int64_t;
 using GUint   = uint64_t;
+// GCC/Clang extension (e.g. for space-filling curve keys exceeding 64 bits)
+__extension__ typedef unsigned __int128 GUint128; // NOLINT(modernize-use-using)
 
 template <GInt NDIM>
 using VectorD = Eigen::Matrix<GDouble, NDIM, 1>;
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef SFCMM_BIT_VECTOR_H
+#define SFCMM_BIT_VECTOR_H
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "common/compiler_config.h"
+#include "common/sfcmm_types.h"
+#include "common/util/first_touch.h"
+
+namespace bits {
+// number of bits of a word
+static constexpr GInt WORD_SIZE = 64;
+
+/// Number of set bits of a word.
+inline auto popcount(const GUint word) -> GInt { return __builtin_popcountll(word); }
+
+/// Mask of the bits [begin, end) of the word containing the first bit.
+/// \param begin First bit (global position).
+/// \param end Bit after the last bit (global position, at most the end of the word).
+inline auto wordMask(const GInt begin, const GInt end) -> GUint {
+  const GInt  first = begin % WORD_SIZE;
+  const GInt  last  = end - (begin - first);
+  const GUint upper = last >= WORD_SIZE ? ~GUint(0) : (GUint(1) << last) - 1;
+  return upper & (~GUint(0) << first);
+}
+
+/// Count the set bits of the range [begin, end) of a bit vector that is given word-wise, e.g., the combination of several
+/// bit vectors (a.word(id) & ~b.word(id)). The bits outside of the range are ignored.
+/// \tparam WordFn Callable returning the word for a given word id.
+/// \param begin First bit.
+/// \param end Bit after the last bit.
+/// \param word Functor returning the word with the given id.
+/// \return Number of set bits.
+template <class WordFn>
+inline auto count(const GInt begin, const GInt end, WordFn&& word) -> GInt {
+  GInt noSetBits = 0;
+  for(GInt first = begin; first < end;) {
+    const GInt wordId = first / WORD_SIZE;
+    const GInt last   = std::min((wordId + 1) * WORD_SIZE, end);
+    noSetBits += popcount(word(wordId) & wordMask(first, last));
+    first = last;
+  }
+  return noSetBits;
+}
+
+/// Call the functor for each set bit of the range [begin, end) of a bit vector that is given word-wise (in ascending
+/// order).
+/// \tparam WordFn Callable returning the word for a given word id.
+/// \tparam Functor Callable taking the position of a set bit.
+/// \param begin First bit.
+/// \param end Bit after the last bit.
+/// \param word Functor returning the word with the given id.
+/// \param fn Functor called for each set bit.
+template <class WordFn, class Functor>
+inline void forEach(const GInt begin, const GInt end, WordFn&& word, Functor&& fn) {
+  for(GInt first = begin; first < end;) {
+    const GInt wordId = first / WORD_SIZE;
+    const GInt last   = std::min((wordId + 1) * WORD_SIZE, end);
+    GUint      w      = word(wordId) & wordMask(first, last);
+    while(w != 0) {
+      fn(wordId * WORD_SIZE + __builtin_ctzll(w));
+      // clear the lowest set bit
+      w &= w - 1;
+    }
+    first = last;
+  }
+}
+} // namespace bits
+
+/// Vector of bits packed into 64-bit words. Single bits are set atomically, hence, several threads can modify different
+/// bits of the same word concurrently. Whole words are accessed non-atomically, i.e., word-wise operations must not be
+/// mixed with concurrent modifications of the same words.
+class BitVector {
+ public:
+  /// Proxy to a single bit.
+  class reference {
+   public:
+    reference(BitVector& vector, const GInt pos) : m_vector(vector), m_pos(pos) {}
+    reference(const reference&) = default;
+    ~reference()                = default;
+
+    auto operator=(const GBool value) -> reference& {
+      m_vector.set(m_pos, value);
+      return *this;
+    }
+    auto operator=(const reference& other) -> reference& { return *this = static_cast<GBool>(other); }
+    operator GBool() const { return std::as_const(m_vector)[m_pos]; }
+
+   private:
+    BitVector& m_vector;
+    GInt       m_pos;
+  };
+
+  BitVector() = default;
+  explicit BitVector(const GInt size) { resize(size); }
+
+  /// Change the number of bits. Added bits are set to the given value.
+  void resize(const GInt size, const GBool value = false) {
+    const GInt oldSize = m_size;
+    m_words.resize((size + bits::WORD_SIZE - 1) / bits::WORD_SIZE, value ? ~GUint(0) : GUint(0));
+    m_size = size;
+    if(size > oldSize) {
+      fill(oldSize, std::min(size, (oldSize + bits::WORD_SIZE - 1) / bits::WORD_SIZE * bits::WORD_SIZE), value);
+    }
+  }
+
+  void clear() {
+    m_words.clear();
+    m_size = 0;
+  }
+
+  [[nodiscard]] auto size() const -> GInt { return m_size; }
+  [[nodiscard]] auto noWords() const -> GInt { return static_cast<GInt>(m_words.size()); }
+
+  [[nodiscard]] auto word(const GInt wordId) const -> GUint { return m_words[wordId]; }
+  [[nodiscard]] auto word(const GInt wordId) -> GUint& { return m_words[wordId]; }
+
+  [[nodiscard]] auto operator[](const GInt pos) const -> GBool {
+    return ((__atomic_load_n(&m_words[pos / bits::WORD_SIZE], __ATOMIC_RELAXED) >> (pos % bits::WORD_SIZE)) & 1U) != 0;
+  }
+  [[nodiscard]] auto operator[](const GInt pos) -> reference { return reference(*this, pos); }
+
+  /// Set a single bit (atomic).
+  void set(const GInt pos, const GBool value = true) {
+    const GUint mask = GUint(1) << (pos % bits::WORD_SIZE);
+    if(value) {
+      __atomic_fetch_or(&m_words[pos / bits::WORD_SIZE], mask, __ATOMIC_RELAXED);
+    } else {
+      __atomic_fetch_and(&m_words[pos / bits::WORD_SIZE], ~mask, __ATOMIC_RELAXED);
+    }
+  }
+
+  void reset(const GInt pos) { set(pos, false); }
+
+  /// Set the bits [begin, end) to the given value. Only the partial words at both ends of the range are modified
+  /// atomically.
+  void fill(const GInt begin, const GInt end, const GBool value) {
+    for(GInt first = begin; first < end;) {
+      const GInt  wordId = first / bits::WORD_SIZE;
+      const GInt  last   = std::min((wordId + 1) * bits::WORD_SIZE, end);
+      const GUint mask   = bits::wordMask(first, last);
+      if(mask == ~GUint(0)) {
+        m_words[wordId] = value ? mask : GUint(0);
+      } else if(value) {
+        __atomic_fetch_or(&m_words[wordId], mask, __ATOMIC_RELAXED);
+      } else {
+        __atomic_fetch_and(&m_words[wordId], ~mask, __ATOMIC_RELAXED);
+      }
+      first = last;
+    }
+  }
+
+  /// Number of set bits of the range [begin, end).
+  [[nodiscard]] auto count(const GInt begin, const GInt end) const -> GInt {
+    return bits::count(begin, end, [&](const GInt wordId) { return m_words[wordId]; });
+  }
+
+  /// Number of set bits.
+  [[nodiscard]] auto count() const -> GInt { return count(0, m_size); }
+
+ private:
+  FirstTouchVector<GUint> m_words{};
+  GInt                    m_size = 0;
+};
+
+#endif // SFCMM_BIT_VECTOR_H
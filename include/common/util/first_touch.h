@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef SFCMM_FIRST_TOUCH_H
+#define SFCMM_FIRST_TOUCH_H
+#include <cstdlib>
+#include <new>
+#include <sys/mman.h>
+#include <vector>
+#include "common/sfcmm_types.h"
+
+namespace memory {
+// size of the pages that are touched (a lower bound of the page size)
+static constexpr std::size_t PAGE_SIZE = 4096;
+// size of a transparent huge page, larger allocations are aligned to it
+static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/// Transparent huge pages are requested for large allocations (see setHugePageHint()).
+inline auto hugePageHint() -> GBool& {
+  static GBool hint = false;
+  return hint;
+}
+
+/// Request transparent huge pages for allocations of at least HUGE_PAGE_SIZE bytes with FirstTouchAllocator. This is only
+/// a hint, the kernel might not provide huge pages (e.g. /sys/kernel/mm/transparent_hugepage/enabled is "never").
+/// \param enabled Request huge pages.
+inline void setHugePageHint(const GBool enabled) { hugePageHint() = enabled; }
+
+/// Touch the pages of a memory range in parallel with a static schedule, such that each page is placed on the NUMA domain
+/// of the thread that processes the corresponding part of the array in a loop with a static schedule.
+/// \param ptr Begin of the memory range.
+/// \param size Size of the memory range in bytes.
+inline void firstTouch(void* ptr, const std::size_t size) {
+  auto*      data    = static_cast<char*>(ptr);
+  const GInt noPages = static_cast<GInt>((size + PAGE_SIZE - 1) / PAGE_SIZE);
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(data, noPages) schedule(static)
+#endif
+  for(GInt page = 0; page < noPages; ++page) {
+    data[page * PAGE_SIZE] = 0;
+  }
+}
+} // namespace memory
+
+/// Allocator for large arrays of cell data that are processed by parallel loops. Allocations of at least
+/// memory::HUGE_PAGE_SIZE bytes are aligned to a huge page, optionally advised to use transparent huge pages and touched
+/// in parallel before the elements are constructed, i.e., the pages are distributed among the NUMA domains of the
+/// threads. Smaller allocations are not touched.
+/// \tparam T Type of the elements.
+template <class T>
+class FirstTouchAllocator {
+ public:
+  using value_type = T;
+
+  FirstTouchAllocator() = default;
+  template <class U>
+  FirstTouchAllocator(const FirstTouchAllocator<U>& /*other*/) noexcept {}
+
+  [[nodiscard]] auto allocate(const std::size_t n) -> T* {
+    const std::size_t size = n * sizeof(T);
+    if(size < memory::HUGE_PAGE_SIZE) {
+      return static_cast<T*>(::operator new(size, std::align_val_t(alignof(T))));
+    }
+    // the size needs to be a multiple of the alignment
+    const std::size_t alignedSize = (size + memory::HUGE_PAGE_SIZE - 1) / memory::HUGE_PAGE_SIZE * memory::HUGE_PAGE_SIZE;
+    void*             ptr         = std::aligned_alloc(memory::HUGE_PAGE_SIZE, alignedSize);
+    if(ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+#ifdef MADV_HUGEPAGE
+    if(memory::hugePageHint()) {
+      madvise(ptr, alignedSize, MADV_HUGEPAGE);
+    }
+#endif
+    memory::firstTouch(ptr, size);
+    return static_cast<T*>(ptr);
+  }
+
+  void deallocate(T* ptr, const std::size_t n) noexcept {
+    if(n * sizeof(T) < memory::HUGE_PAGE_SIZE) {
+      ::operator delete(ptr, std::align_val_t(alignof(T)));
+    } else {
+      std::free(ptr);
+    }
+  }
+};
+
+template <class T, class U>
+inline auto operator==(const FirstTouchAllocator<T>& /*lhs*/, const FirstTouchAllocator<U>& /*rhs*/) -> GBool {
+  return true;
+}
+
+template <class T, class U>
+inline auto operator!=(const FirstTouchAllocator<T>& /*lhs*/, const FirstTouchAllocator<U>& /*rhs*/) -> GBool {
+  return false;
+}
+
+/// Vector of cell data whose pages are distributed among the NUMA domains (see FirstTouchAllocator).
+template <class T>
+using FirstTouchVector = std::vector<T, FirstTouchAllocator<T>>;
+
+namespace memory {
+/// Set the elements [begin, end) of an array to a value in parallel with a static schedule (see firstTouch()).
+/// \param data Array to be filled.
+/// \param begin First element.
+/// \param end Element after the last element.
+/// \param value Value of the elements.
+template <class Vector>
+inline void parallelFill(Vector& data, const GInt begin, const GInt end, const typename Vector::value_type& value) {
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(data, begin, end, value) schedule(static)
+#endif
+  for(GInt id = begin; id < end; ++id) {
+    data[id] = value;
+  }
+}
+} // namespace memory
+
+#endif // SFCMM_FIRST_TOUCH_H
@@ -86,11 +86,12 @@ static inline auto strStreamify(const T* in) -> std::stringstream {
 
 /// Convert an input vector to a string vector of the same size or as per the given optional argument size.
 /// \tparam T Type of the vector.
+/// \tparam Allocator Allocator of the vector.
 /// \param in Input vector to be stringified.
 /// \param size (Default=same as input vector) Provide the size if you want partial stringification.
 /// \return Vector of strings of the input vector.
-template <typename T>
-static inline auto toStringVector(const std::vector<T>& in, GInt size = -1) -> std::vector<GString> {
+template <typename T, class Allocator>
+static inline auto toStringVector(const std::vector<T, Allocator>& in, GInt size = -1) -> std::vector<GString> {
   std::vector<GString> string_vector;
 
   if(size == -1) {
@@ -107,11 +108,12 @@ static inline auto toStringVector(const std::vector<T>& in, GInt size = -1) -> s
 }
 
 /// Convert an input byte vector to a string vector of the same size or as per the given optional argument size. <std::byte version>
+/// \tparam Allocator Allocator of the vector.
 /// \param in Input byte vector to be stringified.
 /// \param size (Default=same as input vector) Provide the size if you want partial stringification.
 /// \return Vector of strings of the input byte vector.
-template <>
-inline auto toStringVector<std::byte>(const std::vector<std::byte>& in, GInt size) -> std::vector<GString> {
+template <class Allocator>
+static inline auto toStringVector(const std::vector<std::byte, Allocator>& in, GInt size = -1) -> std::vector<GString> {
   std::vector<GString> string_vector;
 
   if(size == -1) {
@@ -17,7 +17,11 @@ static constexpr int MAX_DIM = 4;
 #include "common/sfcmm_types.h"
 #include "common/timer.h"
 
+#include "common/algorithm/connected_components.h"
+#include "common/algorithm/curve_partition.h"
 #include "common/algorithm/kdtree.h"
+#include "common/algorithm/parallel_scan.h"
+#include "common/algorithm/radix_sort.h"
 
 #include "common/geometry/circle.h"
 #include "common/geometry/triangle.h"
@@ -25,7 +29,9 @@ static constexpr int MAX_DIM = 4;
 #include "common/util/backtrace.h"
 #include "common/util/base64.h"
 #include "common/util/binary.h"
+#include "common/util/bit_vector.h"
 #include "common/util/eigen.h"
+#include "common/util/first_touch.h"
 #include "common/util/string_helper.h"
 #include "common/util/sys.h"
 
@@ -13,7 +13,7 @@ static void BM_Hilbert2D(benchmark::State& state) {
     //    state.PauseTiming(); // takes more time than the random num gen...
     VectorD<2> quadrant1 = {uniform_dist(e1), uniform_dist(e1)}; // only relevant at hilbertLevel = 1
     //    state.ResumeTiming(); // takes more time than the random num gen...
-    hilbert::index<2>(quadrant1, state.range(0)); //linear behaviour -> level * 1.2 ns
+    benchmark::DoNotOptimize(hilbert::index<2>(quadrant1, state.range(0))); //linear behaviour -> level * 1.2 ns
   }
 }
 // Register the function as a benchmark
@@ -28,12 +28,58 @@ static void BM_Hilbert3D(benchmark::State& state) {
     //    state.PauseTiming(); // takes more time than the random num gen...
     VectorD<3> quadrant1 = {uniform_dist(e1), uniform_dist(e1), uniform_dist(e1)}; // only relevant at hilbertLevel = 1
     //    state.ResumeTiming(); // takes more time than the random num gen...
-    hilbert::index<3>(quadrant1, state.range(0)); //linear behaviour -> level * 1.4 ns
+    benchmark::DoNotOptimize(hilbert::index<3>(quadrant1, state.range(0))); //linear behaviour -> level * 1.4 ns
   }
 }
 // Register the function as a benchmark
 BENCHMARK(BM_Hilbert3D)->DenseRange(1, 10, 1);
 
+template <GInt NDIM>
+static auto randomCoordinates(const GInt noPoints, const GInt bits) -> std::vector<hilbert::Coordinate<NDIM>> {
+  std::random_device                     r;
+  std::default_random_engine             e1(r());
+  std::uniform_int_distribution<GUint32> uniform_dist(0, (1U << bits) - 1);
+
+  std::vector<hilbert::Coordinate<NDIM>> x(noPoints);
+  for(auto& point : x) {
+    for(auto& coord : point) {
+      coord = uniform_dist(e1);
+    }
+  }
+  return x;
+}
+
+static void BM_HilbertKey2D(benchmark::State& state) {
+  const auto x  = randomCoordinates<2>(1024, state.range(0));
+  GInt       id = 0;
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(hilbert::encode<2>(x[id++ & 1023], state.range(0)));
+  }
+}
+BENCHMARK(BM_HilbertKey2D)->DenseRange(1, 10, 1);
+
+static void BM_HilbertKey3D(benchmark::State& state) {
+  const auto x  = randomCoordinates<3>(1024, state.range(0));
+  GInt       id = 0;
+  for(auto _ : state) {
+    benchmark::DoNotOptimize(hilbert::encode<3>(x[id++ & 1023], state.range(0)));
+  }
+}
+BENCHMARK(BM_HilbertKey3D)->DenseRange(1, 10, 1);
+
+static void BM_HilbertKeyBatch3D(benchmark::State& state) {
+  static constexpr int noPoints = 4096;
+  const auto           x        = randomCoordinates<3>(noPoints, state.range(0));
+  std::vector<GUint>   keys(noPoints);
+
+  for(auto _ : state) {
+    hilbert::encode<3>(noPoints, x.data(), state.range(0), keys.data());
+    benchmark::DoNotOptimize(keys.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * noPoints);
+}
+BENCHMARK(BM_HilbertKeyBatch3D)->DenseRange(1, 10, 1)->Arg(21);
+
 // example
 static void BM_memcpy(benchmark::State& state) {
   char* src = new char[state.range(0)];
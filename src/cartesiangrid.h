@@ -18,8 +18,13 @@
 #include "cartesiangrid_generation.h"
 #endif
 #include "interface/grid_interface.h"
+#include "loadbalancing_weights.h"
 
-template <Debug_Level DEBUG_LEVEL, GInt NDIM>
+/// Cartesian grid of the solvers, which is loaded from the grid generator.
+/// \tparam DEBUG_LEVEL Debug level.
+/// \tparam NDIM Number of dimensions.
+/// \tparam LAYOUT Layout policy of the cell connectivity (see CellLayout).
+template <Debug_Level DEBUG_LEVEL, GInt NDIM, typename LAYOUT = DefaultCellLayout>
 class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
  public:
   /// Underlying enum type for property access
@@ -28,8 +33,12 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
   /// Underlying bitset type for property storage
   using PropertyBitsetType = grid::cell::BitsetType;
 
+  using IndexType = typename LAYOUT::IndexType;
+
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::checkBounds;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::property;
+  using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::properties;
+  using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::resetProperties;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::size;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::noCells;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::empty;
@@ -58,34 +67,28 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
   auto operator=(const CartesianGrid&) -> CartesianGrid& = delete;
   auto operator=(CartesianGrid&&) -> CartesianGrid&      = delete;
 
-  inline auto child(const GInt id, const GInt pos) -> GInt& {
+  inline auto child(const GInt id, const GInt pos) -> IndexType& {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       checkChildPos(pos);
       checkBounds(id);
-      return m_childIds.at(id * cartesian::maxNoChildren<NDIM>() + pos);
     }
-    // no bound checking
-    return m_childIds[id * cartesian::maxNoChildren<NDIM>() + pos];
+    return m_childIds(id, pos);
   }
 
   [[nodiscard]] inline auto child(const GInt id, const GInt pos) const -> GInt {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       checkChildPos(pos);
       checkBounds(id);
-      return m_childIds.at(id * cartesian::maxNoChildren<NDIM>() + pos);
     }
-    // no bound checking
-    return m_childIds[id * cartesian::maxNoChildren<NDIM>() + pos];
+    return m_childIds(id, pos);
   }
 
   [[nodiscard]] inline auto hasChild(const GInt id, const GInt pos) const -> GBool {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       checkChildPos(pos);
       checkBounds(id);
-      return m_childIds.at(id * cartesian::maxNoChildren<NDIM>() + pos) > -1;
     }
-    // no bound checking
-    return m_childIds[id * cartesian::maxNoChildren<NDIM>() + pos] > -1;
+    return m_childIds(id, pos) > -1;
   }
 
   [[nodiscard]] inline auto hasChildren(const GInt id) const -> GBool {
@@ -99,43 +102,31 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       checkBounds(id);
     }
-    return std::count_if(&m_childIds[id * cartesian::maxNoChildren<NDIM>() + 0],
-                         &m_childIds[id * cartesian::maxNoChildren<NDIM>() + cartesian::maxNoChildren<NDIM>()],
-                         [](const GInt childId) { return childId > -1; });
+    GInt count = 0;
+    for(GInt pos = 0; pos < cartesian::maxNoChildren<NDIM>(); ++pos) {
+      count += static_cast<GInt>(m_childIds(id, pos) > -1);
+    }
+    return count;
   }
 
   // Neighbors
   inline auto neighbor() const -> const auto& { return m_nghbrIds; }
 
-  // todo: make diagonal neighbors a template parameter
+  // the neighbor storage always has room for the diagonal neighbors
   [[nodiscard]] inline auto neighbor(const GInt id, const GInt dir) const -> GInt override {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       checkBounds(id);
       //      checkDir(dir);
-      if(m_diagonalNghbrs) {
-        return m_nghbrIds.at(id * cartesian::maxNoNghbrsDiag<NDIM>() + dir);
-      }
-      return m_nghbrIds.at(id * cartesian::maxNoNghbrs<NDIM>() + dir);
-    }
-    if(m_diagonalNghbrs) {
-      return m_nghbrIds[id * cartesian::maxNoNghbrsDiag<NDIM>() + dir];
     }
-    return m_nghbrIds[id * cartesian::maxNoNghbrs<NDIM>() + dir];
+    return m_nghbrIds(id, dir);
   }
 
-  inline auto neighbor(const GInt id, const GInt dir) -> GInt& {
+  inline auto neighbor(const GInt id, const GInt dir) -> IndexType& {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       checkBounds(id);
       //      checkDir(dir);
-      if(m_diagonalNghbrs) {
-        return m_nghbrIds.at(id * cartesian::maxNoNghbrsDiag<NDIM>() + dir);
-      }
-      return m_nghbrIds.at(id * cartesian::maxNoNghbrs<NDIM>() + dir);
-    }
-    if(m_diagonalNghbrs) {
-      return m_nghbrIds[id * cartesian::maxNoNghbrsDiag<NDIM>() + dir];
     }
-    return m_nghbrIds[id * cartesian::maxNoNghbrs<NDIM>() + dir];
+    return m_nghbrIds(id, dir);
   }
 
 
@@ -143,15 +134,8 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       checkBounds(id);
       checkDir(dir);
-      if(m_diagonalNghbrs) {
-        return m_nghbrIds.at(id * cartesian::maxNoNghbrsDiag<NDIM>() + dir) != INVALID_CELLID;
-      }
-      return m_nghbrIds.at(id * cartesian::maxNoNghbrs<NDIM>() + dir) != INVALID_CELLID;
-    }
-    if(m_diagonalNghbrs) {
-      return m_nghbrIds[id * cartesian::maxNoNghbrsDiag<NDIM>() + dir] != INVALID_CELLID;
     }
-    return m_nghbrIds[id * cartesian::maxNoNghbrs<NDIM>() + dir] != INVALID_CELLID;
+    return m_nghbrIds(id, dir) != INVALID_CELLID;
   }
 
   [[nodiscard]] inline auto hasAnyNeighbor(const GInt id, const GInt dir) const -> GBool {
@@ -219,12 +203,19 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
 
   [[nodiscard]] inline auto noBndCells() const -> GInt { return m_noBndCells; }
 
+  /// Number of cells whose boundary check was skipped, since their parent has no cut with the geometry.
+  [[nodiscard]] inline auto noSkippedBndryChecks() const -> GInt { return m_noSkippedBndryChecks; }
+
   void setCapacity(const GInt _capacity) override {
     if(!empty()) {
       TERMM(-1, "Invalid operation tree already allocated.");
     }
-    m_childIds.resize(_capacity * cartesian::maxNoChildren<NDIM>());
-    m_nghbrIds.resize(_capacity * cartesian::maxNoNghbrsDiag<NDIM>());
+    if(_capacity > LAYOUT::maxNoCells()) {
+      TERMM(-1, "The capacity of " + std::to_string(_capacity) + " cells exceeds the cell ids of the grid layout (max. "
+                    + std::to_string(LAYOUT::maxNoCells()) + " cells), enable GRIDGEN_64BIT_CELLIDS.");
+    }
+    m_childIds.resize(_capacity);
+    m_nghbrIds.resize(_capacity);
     m_weight.resize(_capacity);
     m_noOffsprings.resize(_capacity);
     m_workload.resize(_capacity);
@@ -233,21 +224,19 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
   }
 
   void reset() override {
-    std::fill(m_childIds.begin(), m_childIds.end(), INVALID_CELLID);
-    std::fill(m_nghbrIds.begin(), m_nghbrIds.end(), INVALID_CELLID);
-    std::fill(m_weight.begin(), m_weight.end(), NAN);
-    std::fill(m_noOffsprings.begin(), m_noOffsprings.end(), INVALID_CELLID);
-    std::fill(m_workload.begin(), m_workload.end(), NAN);
-    for(GInt i = 0; i < capacity(); ++i) {
-      property(i).reset();
-      center(i).fill(NAN);
-    }
+    // the arrays are initialized with the static schedule of the loops over the cells (first touch)
+    m_childIds.invalidate(0, capacity());
+    m_nghbrIds.invalidate(0, capacity());
+    memory::parallelFill(m_weight, 0, capacity(), NAN);
+    memory::parallelFill(m_noOffsprings, 0, capacity(), INVALID_CELLID);
+    memory::parallelFill(m_workload, 0, capacity(), NAN);
+    memory::parallelFill(center(), 0, capacity(), Point<NDIM>::Constant(NAN));
     BaseCartesianGrid<DEBUG_LEVEL, NDIM>::reset();
   }
 
   void save(const GString& /*fileName*/, const json& /*gridOutConfig*/) const override { TERMM(-1, "Not implemented!"); }
 
-  auto bndrySurface(const GString& id) -> Surface<DEBUG_LEVEL, NDIM>& {
+  auto bndrySurface(const GString& id) -> Surface<DEBUG_LEVEL, NDIM, LAYOUT>& {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       if(m_bndrySurfaces.count(id) == 0) {
         TERMM(-1, "Invalid bndryId \"" + id + "\"");
@@ -261,8 +250,9 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
 
   /// Load the generated grid in-memory and set additional properties
   /// \param grid Generated grid.
-  void loadGridInplace(const CartesianGridGen<DEBUG_LEVEL, NDIM>& grid, std::shared_ptr<ConfigurationAccess> properties) {
-    m_config = properties;
+  /// \param config Configuration of the grid.
+  void loadGridInplace(const CartesianGridGen<DEBUG_LEVEL, NDIM, LAYOUT>& grid, std::shared_ptr<ConfigurationAccess> config) {
+    m_config = config;
     // grid.balance(); //todo: implement
     setCapacity(grid.capacity()); // todo: change for adaptation
     m_geometry              = grid.geometry();
@@ -298,27 +288,67 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     }
 #endif
 
-    m_axisAlignedBnd = m_config->opt_config_value<GBool>("assumeAxisAligned", m_axisAlignedBnd);
-    m_periodic       = m_config->has_any_key_value("type", "periodic");
+    setupLoadedGrid();
+  }
 
-    setProperties();
+  /// Take over the generated grid without copying the cell data and set additional properties. The buffers of the
+  /// generator are moved and the neighbor storage is extended by the diagonal neighbors, hence, the grid is not held
+  /// twice in memory. The generator is released afterwards.
+  /// \param grid Generated grid.
+  /// \param config Configuration of the grid.
+  void loadGrid(CartesianGridGen<DEBUG_LEVEL, NDIM, LAYOUT>&& grid, std::shared_ptr<ConfigurationAccess> config) {
+    if(!empty()) {
+      TERMM(-1, "Invalid operation tree already allocated.");
+    }
+    m_config                = config;
+    m_geometry              = grid.geometry();
+    ref_currentHighestLvl() = grid.currentHighestLvl();
+    ref_partitionLvl()      = grid.partitionLvl();
+    setMaxLvl(grid.maxLvl());
+    setBoundingBox(grid.boundingBox());
+    transformMaxLvl(grid.lengthOnLvl(maxLvl()) / lengthOnLvl(maxLvl()));
 
-    determineBoundaryCells();
-    identifyBndrySurfaces();
-    setupPeriodicConnections();
-    // todo: rename add interface cells...
-    //    addGhostCells();
-    addDiagonalNghbrs();
+    // the generator derives the centers from the cell coordinates, which are kept until the centers are set, i.e., only
+    // the coordinates are held in addition to the grid and not the remaining buffers of the generator
+    const FirstTouchVector<CellCoordinate<NDIM>> coordinates = grid.releaseCoordinates();
+    m_childIds                                               = grid.releaseChildren();
+    m_nghbrIds.assign(grid.releaseNeighbors());
+    BaseCartesianGrid<DEBUG_LEVEL, NDIM>::moveCellData(std::move(grid));
+    grid.releaseMemory();
 
-    //    for(auto& [name, srf] : m_bndrySurfaces) {
-    //      srf.updateNeighbors();
-    //    }
-    //    if(m_loadBalancing) {
-    //      setWorkload();
-    //      calculateOffspringsAndWeights();
-    //    }
+    center().resize(capacity());
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(grid, coordinates) schedule(static)
+#endif
+    for(GInt cellId = 0; cellId < noCells(); ++cellId) {
+      center(cellId) = grid.center(coordinates[cellId], std::to_integer<GInt>(level(cellId)));
+    }
+    m_weight.resize(capacity());
+    m_noOffsprings.resize(capacity());
+    m_workload.resize(capacity());
+    memory::parallelFill(m_weight, 0, capacity(), NAN);
+    memory::parallelFill(m_noOffsprings, 0, capacity(), INVALID_CELLID);
+    memory::parallelFill(m_workload, 0, capacity(), NAN);
+    // the properties are determined from scratch as for a copied grid
+    this->props().reset(0, noCells());
+    invalidate(noCells(), capacity());
+
+    setupLoadedGrid();
   }
 
+  /// Take over the grid released by another runnable (see Runnable::transferGrid()). The grid needs to be a generated grid
+  /// of the same dimension and cell layout, which is moved (see loadGrid()).
+  /// \param grid Grid to take over.
+  /// \param config Configuration of the grid.
+  void loadGrid(std::unique_ptr<GridInterface> grid, std::shared_ptr<ConfigurationAccess> config) {
+    auto* generatedGrid = dynamic_cast<CartesianGridGen<DEBUG_LEVEL, NDIM, LAYOUT>*>(grid.get());
+    if(generatedGrid == nullptr) {
+      TERMM(-1, "Only a generated grid of the same dimension and cell layout can be moved!");
+    }
+    loadGrid(std::move(*generatedGrid), std::move(config));
+  }
+
+
   /// Add ghost cells
   void addGhostCells() {
     struct PossibleBndGhost {
@@ -452,7 +482,7 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     m_diagonalNghbrs = true;
     auto tmpNghbr    = m_nghbrIds;
 
-    auto tmpN = [&](const GInt cellId, const GInt dir) { return tmpNghbr[cellId * cartesian::maxNoNghbrs<NDIM>() + dir]; };
+    auto tmpN = [&](const GInt cellId, const GInt dir) { return tmpNghbr(cellId, dir); };
 
 
     for(GInt cellId = offset; cellId < size() + m_noGhostsCells; ++cellId) {
@@ -492,31 +522,66 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     }
   }
 
-  auto getCartesianGridData() -> CartesianGridData<NDIM> { return CartesianGridData<NDIM>(*this); }
+  auto getCartesianGridData() -> CartesianGridData<NDIM, LAYOUT> { return CartesianGridData<NDIM, LAYOUT>(*this); }
 
   auto totalSize() const -> GInt { return size() + m_noGhostsCells; }
 
   auto isBndryCell(const GInt cellId) const -> GBool { return property(cellId, CellProperties::bndry); }
 
  private:
+  /// Set the additional properties of a loaded grid.
+  void setupLoadedGrid() {
+    m_axisAlignedBnd = m_config->opt_config_value<GBool>("assumeAxisAligned", m_axisAlignedBnd);
+    m_periodic       = m_config->has_any_key_value("type", "periodic");
+    m_loadBalancing  = m_config->opt_config_value<GBool>("loadBalancing", m_loadBalancing);
+    if(m_loadBalancing) {
+      // the level weighting is relative to the partitioning level as for the grid generation
+      m_weightMethod = weightMethodFactory(m_config->opt_config_value<json>("weightMethod", json::object()), partitionLvl());
+    }
+
+    setProperties();
+
+    determineBoundaryCells();
+    identifyBndrySurfaces();
+    setupPeriodicConnections();
+    // todo: rename add interface cells...
+    //    addGhostCells();
+    addDiagonalNghbrs();
+
+    //    for(auto& [name, srf] : m_bndrySurfaces) {
+    //      srf.updateNeighbors();
+    //    }
+    if(m_loadBalancing) {
+      setWorkload(*m_weightMethod);
+      calculateOffspringsAndWeights();
+    }
+  }
+
   void setProperties() {
     for(GInt cellId = 0; cellId < noCells(); ++cellId) {
-      const GBool isLeaf                     = noChildren(cellId) == 0;
-      property(cellId, CellProperties::leaf) = isLeaf;
-      m_noLeafCells += static_cast<GInt>(isLeaf);
+      property(cellId, CellProperties::leaf) = noChildren(cellId) == 0;
     }
+    m_noLeafCells = this->props().count(CellProperties::leaf, 0, noCells());
   };
 
   void determineBoundaryCells() {
+    // the boundary property is removed from cells without a missing neighbor, so the cut is tracked separately
+    std::vector<GBool> hasCut(noCells(), false);
+    m_noSkippedBndryChecks = 0;
     for(GInt cellId = 0; cellId < noCells(); ++cellId) {
       // is a partition cell determine for each if it can be a boundary cell
       // cell has no parent -> might have cut
       // parent has a cut with the boundary -> possible cut of child!
-      if(parent(cellId) == -1 || property(parent(cellId), CellProperties::bndry)) {
+      // parent is inside without a cut -> the child is inside without a cut as well
+      if(parent(cellId) != -1 && !hasCut[parent(cellId)]) {
+        property(cellId, CellProperties::bndry) = false;
+        ++m_noSkippedBndryChecks;
+      } else {
         const GDouble cellLength = lengthOnLvl(std::to_integer<GInt>(level(cellId)));
 
         // check for cut with geometry
-        property(cellId, CellProperties::bndry) = m_geometry->cutWithCell(center(cellId), cellLength);
+        hasCut[cellId]                          = m_geometry->cutWithCell(center(cellId), cellLength);
+        property(cellId, CellProperties::bndry) = hasCut[cellId];
         //        if(DEBUG_LEVEL > Debug_Level::min_debug && property(cellId, CellProperties::bndry)){
 
         // we currently only care for cells which have missing neighbors!
@@ -541,8 +606,10 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
           }
         }
       }
-      m_noBndCells += static_cast<GInt>(property(cellId, CellProperties::bndry) && property(cellId, CellProperties::leaf));
     }
+    m_noBndCells = this->props().countAnd(CellProperties::bndry, CellProperties::leaf, 0, noCells());
+    logger << "Skipped the boundary check of " << m_noSkippedBndryChecks << " of " << noCells()
+           << " cells with a parent without a cut" << std::endl;
   }
 
 #ifdef CLANG_COMPILER
@@ -550,55 +617,116 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
 #pragma clang diagnostic ignored "-Wunknown-pragmas"
 #pragma ide diagnostic   ignored "cppcoreguidelines-pro-bounds-constant-array-index"
 #endif
+  /// Assign the missing neighbor directions of the boundary cells to the boundary surfaces of the configuration. The
+  /// geometry is queried once per boundary cell for all configured objects. A direction is assigned to the first surface in
+  /// the configuration that matches, i.e., the surfaces keep the order of the cells (per direction) of a separate pass
+  /// per surface and direction.
   void identifyBndrySurfaces() {
     json bndryConfig = m_config->getObject("boundary");
 
     cerr0 << "Create boundary surfaces for " << m_geometry->noObjects() << " geometries" << std::endl;
 
-    std::set<std::pair<GInt, GInt>> assignedBnds;
+    static_assert(cartesian::maxNoNghbrs<NDIM>() <= 8, "Directions don't fit into the bitmask!");
 
-    // iterate over all geometries
+    // surface/direction entries of the configuration in order of precedence
+    struct BndryEntry {
+      GString       name;
+      std::uint64_t object = 0;
+      std::uint8_t  dirs   = 0;
+    };
+    std::vector<BndryEntry> entries;
+    std::uint64_t           objects = 0;
     for(const auto& [surfName, surfConfig] : bndryConfig.items()) {
       const GInt noBnds = surfConfig.size();
+      const GInt objId  = m_geometry->objectId(surfName);
+      if(objId >= GeometryManager<DEBUG_LEVEL, NDIM>::MAX_NO_MASKED_OBJECTS) {
+        TERMM(-1, "Too many geometry objects for the boundary surface " + surfName);
+      }
       for(const auto& [surfDirName, config] : surfConfig.items()) {
         const GString surfNameAp = (noBnds > 1) ? surfName + "_" + surfDirName : surfName;
         cerr0 << "Surface name: " << surfNameAp << std::endl;
         cerr0 << "bndConfig: " << config << std::endl;
-        m_bndrySurfaces.insert(std::make_pair(surfNameAp, Surface<DEBUG_LEVEL, NDIM>(this->getCartesianGridData(), &property(0))));
+        m_bndrySurfaces.insert(std::make_pair(surfNameAp, Surface<DEBUG_LEVEL, NDIM, LAYOUT>(this->getCartesianGridData(), &this->props())));
 
         // use "all" to set all direction for this bnd
         const GInt dirBegin = surfDirName == "all" ? 0 : dirIdString2Id(surfDirName);
         const GInt dirEnd   = surfDirName == "all" ? cartesian::maxNoNghbrs<NDIM>() : dirIdString2Id(surfDirName) + 1;
 
+        BndryEntry entry{surfNameAp, objId < 0 ? 0 : std::uint64_t(1) << objId, 0};
         for(GInt dir = dirBegin; dir < dirEnd; ++dir) {
-          for(GInt cellId = 0; cellId < size(); ++cellId) {
-            if(property(cellId, Cell::bndry)) {
-              const GDouble cellLength = lengthOnLvl(std::to_integer<GInt>(level(cellId)));
-              if(!hasNeighbor(cellId, dir)) {
-                // cell has cut with the boundary surface
-                if(m_geometry->cutWithCell(surfName, center(cellId), cellLength)) {
-                  const auto [iter, added] = assignedBnds.insert({cellId, dir});
-
-                  if(added) {
-                    // todo: diagonal missing cells are not assigned!
-                    //                    cerr0 << surfName << " : " << cellId << std::endl;
-                    m_bndrySurfaces.at(surfNameAp).addCell(cellId, dir);
-                  } else {
-                    cerr0 << "cellId: " << cellId << " was already assigned a bnd in direction " << dir << std::endl;
-                  }
-                }
-              }
-            }
+          entry.dirs |= static_cast<std::uint8_t>(1U << dir);
+        }
+        objects |= entry.object;
+        entries.emplace_back(entry);
+      }
+    }
+
+    std::vector<GInt> bndryCells;
+    for(GInt cellId = 0; cellId < size(); ++cellId) {
+      if(property(cellId, Cell::bndry)) {
+        bndryCells.emplace_back(cellId);
+      }
+    }
+
+    // flat per cell bitmasks of the missing neighbors and the objects cutting the cell
+    const GInt                 noBndryCells = bndryCells.size();
+    std::vector<std::uint8_t>  missingDirs(noBndryCells, 0);
+    std::vector<std::uint64_t> cutObjects(noBndryCells, 0);
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(noBndryCells, bndryCells, missingDirs, cutObjects, objects) schedule(dynamic, 64)
+#endif
+    for(GInt id = 0; id < noBndryCells; ++id) {
+      const GInt cellId = bndryCells[id];
+      for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>(); ++dir) {
+        if(!hasNeighbor(cellId, dir)) {
+          missingDirs[id] |= static_cast<std::uint8_t>(1U << dir);
+        }
+      }
+      if(missingDirs[id] != 0) {
+        const GDouble cellLength = lengthOnLvl(std::to_integer<GInt>(level(cellId)));
+        cutObjects[id]           = m_geometry->cutObjects(center(cellId), cellLength, objects);
+      }
+    }
+
+    // assign the directions in order of the cells, such that the cells of each surface and direction stay sorted
+    std::vector<std::array<std::vector<GInt>, cartesian::maxNoNghbrs<NDIM>()>> assignedCells(entries.size());
+    GInt                                                                       noReassigned = 0;
+    for(GInt id = 0; id < noBndryCells; ++id) {
+      std::uint8_t assigned = 0;
+      for(std::size_t entryId = 0; entryId < entries.size(); ++entryId) {
+        if((cutObjects[id] & entries[entryId].object) == 0) {
+          continue;
+        }
+        const std::uint8_t dirs = entries[entryId].dirs & missingDirs[id];
+        noReassigned += bits::popcount(dirs & assigned);
+        for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>(); ++dir) {
+          if((dirs & ~assigned & (1U << dir)) != 0) {
+            // todo: diagonal missing cells are not assigned!
+            assignedCells[entryId][dir].emplace_back(bndryCells[id]);
           }
         }
-        if(m_bndrySurfaces.at(surfNameAp).size() == 0) {
-          //            m_bndrySurfaces.erase(surfNameAp);
-          cerr0 << "WARNING: surface " << surfNameAp << " has no cells!" << std::endl;
-          logger << "WARNING: surface " << surfNameAp << " has no cells!" << std::endl;
-        } else {
-          cerr0 << "Surface assigned " << m_bndrySurfaces.at(surfNameAp).size() << " cells" << std::endl;
+        assigned |= dirs;
+      }
+    }
+    if(noReassigned > 0) {
+      cerr0 << noReassigned << " boundary directions of cells were already assigned to another surface" << std::endl;
+    }
+
+    for(std::size_t entryId = 0; entryId < entries.size(); ++entryId) {
+      const GString& surfNameAp = entries[entryId].name;
+      auto&          surface    = m_bndrySurfaces.at(surfNameAp);
+      for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>(); ++dir) {
+        for(const GInt cellId : assignedCells[entryId][dir]) {
+          surface.addCell(cellId, dir);
         }
       }
+      if(surface.size() == 0) {
+        //            m_bndrySurfaces.erase(surfNameAp);
+        cerr0 << "WARNING: surface " << surfNameAp << " has no cells!" << std::endl;
+        logger << "WARNING: surface " << surfNameAp << " has no cells!" << std::endl;
+      } else {
+        cerr0 << "Surface assigned " << surface.size() << " cells" << std::endl;
+      }
     }
   }
 #ifdef CLANG_COMPILER
@@ -642,7 +770,7 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
 
   // todo: fix for refinement level changes
   // todo: simplify
-  void addPeriodicConnection(const Surface<DEBUG_LEVEL, NDIM>& surfA, const Surface<DEBUG_LEVEL, NDIM>& surfB) {
+  void addPeriodicConnection(const Surface<DEBUG_LEVEL, NDIM, LAYOUT>& surfA, const Surface<DEBUG_LEVEL, NDIM, LAYOUT>& surfB) {
     // connect cells of surfA and surfB
     for(const GInt cellIdA : surfA.getCellList()) {
       for(const GInt cellIdB : surfB.getCellList()) {
@@ -706,26 +834,63 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
   }
 
 
-  void setWorkload() { TERMM(-1, "Not implemented!"); };
-  void calculateOffspringsAndWeights() { TERMM(-1, "Not implemented!"); };
+  /// Set the weight of each cell.
+  /// \param weightMethod Workload of the cells.
+  void setWorkload(const WeightMethod& weightMethod) {
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(weightMethod)
+#endif
+    for(GInt cellId = 0; cellId < size(); ++cellId) {
+      weight(cellId) = weightMethod.weight(properties(cellId), std::to_integer<GInt>(level(cellId)));
+    }
+  }
+
+  /// Accumulate the number of offsprings and the workload of the subtree of each cell bottom-up level by level.
+  void calculateOffspringsAndWeights() {
+#ifdef _OPENMP
+#pragma omp parallel default(none)
+    {
+#pragma omp for
+#endif
+      for(GInt cellId = 0; cellId < size(); ++cellId) {
+        noOffsprings(cellId) = 1;
+        workload(cellId)     = weight(cellId);
+      }
+      for(GInt lvl = currentHighestLvl() - 1; lvl >= partitionLvl(); --lvl) {
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for(GInt cellId = 0; cellId < size(); ++cellId) {
+          if(std::to_integer<GInt>(level(cellId)) != lvl) {
+            continue;
+          }
+          for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
+            const GInt childCellId = child(cellId, childId);
+            if(childCellId != INVALID_CELLID) {
+              noOffsprings(cellId) += noOffsprings(childCellId);
+              workload(cellId) += workload(childCellId);
+            }
+          }
+        }
+      }
+#ifdef _OPENMP
+    }
+#endif
+  }
 
   void invalidate(const GInt begin, const GInt end) {
-    std::fill(&parent(begin), &parent(end), INVALID_CELLID);
-    std::fill(m_childIds.begin() + begin * cartesian::maxNoChildren<NDIM>(),
-              m_childIds.begin() + end * cartesian::maxNoChildren<NDIM>(),
-              INVALID_CELLID);
-    std::fill(m_nghbrIds.begin() + begin * cartesian::maxNoNghbrsDiag<NDIM>(),
-              m_nghbrIds.begin() + end * cartesian::maxNoNghbrsDiag<NDIM>(),
-              INVALID_CELLID);
-    std::fill(&globalId(begin), &globalId(end), INVALID_CELLID);
-    std::fill(&level(begin), &level(end), std::byte(-1));
-    std::fill(&center(begin), center(end), NAN);
+    for(GInt cellId = begin; cellId < end; ++cellId) {
+      parent(cellId)   = INVALID_CELLID;
+      globalId(cellId) = INVALID_CELLID;
+      level(cellId)    = std::byte(-1);
+      center(cellId).fill(NAN);
+    }
+    m_childIds.invalidate(begin, end);
+    m_nghbrIds.invalidate(begin, end);
     std::fill(m_weight.begin() + begin, m_weight.begin() + end, NAN);
     std::fill(m_noOffsprings.begin() + begin, m_noOffsprings.begin() + end, INVALID_CELLID);
     std::fill(m_workload.begin() + begin, m_workload.begin() + end, NAN);
-    for(GInt i = 0; i < capacity(); ++i) {
-      property(i).reset();
-    }
+    this->props().reset(begin, end);
   }
 
   //  template <class Functor, class T>
@@ -818,24 +983,28 @@ class CartesianGrid : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
   //  cartesian::Tree<DEBUG_LEVEL, NDIM> m_tree{};
   std::shared_ptr<GeometryManager<DEBUG_LEVEL, NDIM>> m_geometry;
 
-  GInt m_noLeafCells   = 0;
-  GInt m_noBndCells    = 0;
-  GInt m_noGhostsCells = 0;
+  GInt m_noLeafCells          = 0;
+  GInt m_noBndCells           = 0;
+  GInt m_noGhostsCells        = 0;
+  GInt m_noSkippedBndryChecks = 0;
 
   GBool m_loadBalancing  = false;
   GBool m_diagonalNghbrs = false;
   GBool m_axisAlignedBnd = false;
   GBool m_periodic       = false;
 
-  std::unordered_map<GString, Surface<DEBUG_LEVEL, NDIM>> m_bndrySurfaces;
+  std::unordered_map<GString, Surface<DEBUG_LEVEL, NDIM, LAYOUT>> m_bndrySurfaces;
 
   // Data containers
-  std::vector<GInt> m_childIds{};
-  std::vector<GInt> m_nghbrIds{};
-  std::vector<GInt> m_noOffsprings{};
+  CellConnectivity<LAYOUT, cartesian::maxNoChildren<NDIM>()>   m_childIds{};
+  CellConnectivity<LAYOUT, cartesian::maxNoNghbrsDiag<NDIM>()> m_nghbrIds{};
+  FirstTouchVector<GInt>                                       m_noOffsprings{};
+
+  FirstTouchVector<GFloat> m_weight{};
+  FirstTouchVector<GFloat> m_workload{};
 
-  std::vector<GFloat> m_weight{};
-  std::vector<GFloat> m_workload{};
+  // workload of the cells for the load balancing (see weightMethodFactory())
+  std::unique_ptr<WeightMethod> m_weightMethod;
 
   std::shared_ptr<ConfigurationAccess> m_config;
 };
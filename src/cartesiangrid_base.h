@@ -4,6 +4,7 @@
 #include <gcem.hpp>
 
 #include <sfcmm_common.h>
+#include "cell_layout.h"
 // #include "celltree.h"
 // #include "common/IO.h"
 #include "geometry.h"
@@ -17,30 +18,25 @@ struct LevelOffsetType {
   GInt end;
 };
 
-inline auto levelSize(LevelOffsetType& level) -> GInt { return level.end - level.begin; }
+inline auto levelSize(const LevelOffsetType& level) -> GInt { return level.end - level.begin; }
 
 template <GInt NDIM>
 using Point = VectorD<NDIM>;
 
+/// Integer coordinates of a cell on the uniform grid of its level.
 template <GInt NDIM>
-struct /*alignas(64)*/ NeighborList {
-  std::array<GInt, cartesian::maxNoNghbrs<NDIM>()> n{INVALID_LIST<cartesian::maxNoNghbrs<NDIM>()>()};
-};
-
-template <GInt NDIM>
-struct /*alignas(64)*/ ChildList {
-  std::array<GInt, cartesian::maxNoChildren<NDIM>()> c{INVALID_LIST<cartesian::maxNoChildren<NDIM>()>()};
-};
+using CellCoordinate = std::array<GUint32, NDIM>;
 
 template <Debug_Level DEBUG_LEVEL, GInt NDIM>
 class BaseCartesianGrid;
 
 /// Data access object to give const-level access to an existing cartesian grid.
 /// \tparam NDIM
-template <GInt NDIM>
+/// \tparam LAYOUT Layout policy of the cell connectivity (see CellLayout).
+template <GInt NDIM, typename LAYOUT = DefaultCellLayout>
 class CartesianGridData {
  private:
-  using PropertyBitsetType = grid::cell::BitsetType;
+  using PropertyStorageType = CellPropertyStorage<DEFAULT_PROPERTY_STORAGE>;
 
  public:
   template <typename T>
@@ -67,7 +63,7 @@ class CartesianGridData {
 
   [[nodiscard]] inline auto isLeaf(const GInt cellId) const -> GBool {
     ASSERT(cellId >= 0 and cellId < m_noCells, "Invalid cellId");
-    return m_properties[cellId][static_cast<GInt>(CellProperties::leaf)];
+    return m_properties(cellId, CellProperties::leaf);
   }
 
   [[nodiscard]] inline auto level(const GInt cellId) const -> std::byte {
@@ -83,10 +79,10 @@ class CartesianGridData {
   [[nodiscard]] inline auto boundingBox() const -> const BoundingBoxInterface& { return m_boundingBox; }
 
   [[nodiscard]] inline auto neighbor(const GInt id, const GInt dir) const -> GInt {
-    return m_nghbrIds[id * cartesian::maxNoNghbrsDiag<NDIM>() + dir];
+    return m_nghbrIds(id, dir);
   }
 
-  [[nodiscard]] inline auto property(const GInt id, CellProperties p) const -> GBool { return m_properties[id][static_cast<GInt>(p)]; }
+  [[nodiscard]] inline auto property(const GInt id, CellProperties p) const -> GBool { return m_properties(id, p); }
 
   [[nodiscard]] inline auto currentHighestLvl() const -> GInt { return m_currentHighestLvl; }
 
@@ -96,12 +92,12 @@ class CartesianGridData {
  private:
   const GInt m_noCells = -1;
 
-  const BoundingBoxInterface&            m_boundingBox;
-  const std::vector<Point<NDIM>>&        m_center;
-  const std::vector<PropertyBitsetType>& m_properties;
-  const std::vector<std::byte>&          m_level;
-  const std::vector<GInt>&               m_nghbrIds;
-  const std::array<GDouble, MAX_LVL>     m_lengthOnLevel{NAN_LIST<MAX_LVL>()};
+  const BoundingBoxInterface&                                         m_boundingBox;
+  const FirstTouchVector<Point<NDIM>>&                                m_center;
+  const PropertyStorageType&                                          m_properties;
+  const FirstTouchVector<std::byte>&                                  m_level;
+  const CellConnectivity<LAYOUT, cartesian::maxNoNghbrsDiag<NDIM>()>& m_nghbrIds;
+  const std::array<GDouble, MAX_LVL>                                  m_lengthOnLevel{NAN_LIST<MAX_LVL>()};
 
   const GInt& m_partitionLvl;
   const GInt& m_currentHighestLvl;
@@ -110,7 +106,8 @@ class CartesianGridData {
 template <Debug_Level DEBUG_LEVEL, GInt NDIM>
 class BaseCartesianGrid : public GridInterface {
  public:
-  using PropertyBitsetType = grid::cell::BitsetType;
+  using PropertyBitsetType  = grid::cell::BitsetType;
+  using PropertyStorageType = CellPropertyStorage<DEFAULT_PROPERTY_STORAGE>;
 
   /// Underlying enum type for property access
   using Cell = CellProperties;
@@ -189,26 +186,33 @@ class BaseCartesianGrid : public GridInterface {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       //      checkBounds(id);
       checkProperty(p);
-      return m_properties.at(id)[grid::cell::p(p)];
+      ASSERT(id >= 0 && id < m_properties.capacity(), "Out of bounds id: " + std::to_string(id));
     }
-    return m_properties[id][static_cast<GInt>(p)];
+    return m_properties(id, p);
   }
 
   [[nodiscard]] inline auto property(const GInt id, CellProperties p) const -> GBool override {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       checkBounds(id);
       checkProperty(p);
-      return m_properties.at(id)[grid::cell::p(p)];
     }
-    return m_properties[id][static_cast<GInt>(p)];
+    return m_properties(id, p);
   }
 
-  inline auto property(const GInt id) -> PropertyBitsetType& {
+  /// All properties of a cell.
+  [[nodiscard]] inline auto properties(const GInt id) const -> PropertyBitsetType {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       checkBounds(id);
-      return m_properties.at(id);
     }
-    return m_properties[id];
+    return m_properties.get(id);
+  }
+
+  /// Set all properties of a cell.
+  void assignProperties(const GInt id, const PropertyBitsetType& bits) {
+    if(DEBUG_LEVEL >= Debug_Level::debug) {
+      checkBounds(id);
+    }
+    m_properties.set(id, bits);
   }
 
   [[nodiscard]] inline auto center(const GInt id, const GInt dir) const -> GDouble {
@@ -226,7 +230,7 @@ class BaseCartesianGrid : public GridInterface {
     return m_center[id];
   }
 
-  inline auto center() const -> const std::vector<Point<NDIM>>& { return m_center; }
+  inline auto center() const -> const FirstTouchVector<Point<NDIM>>& { return m_center; }
 
 
   [[nodiscard]] inline auto level(const GInt id) const -> std::byte override {
@@ -237,8 +241,8 @@ class BaseCartesianGrid : public GridInterface {
     return m_level[id];
   }
 
-  [[nodiscard]] inline auto level() -> std::vector<std::byte>& { return m_level; }
-  [[nodiscard]] inline auto level() const -> const std::vector<std::byte>& { return m_level; }
+  [[nodiscard]] inline auto level() -> FirstTouchVector<std::byte>& { return m_level; }
+  [[nodiscard]] inline auto level() const -> const FirstTouchVector<std::byte>& { return m_level; }
 
   [[nodiscard]] inline auto globalId(const GInt id) const -> GInt {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
@@ -248,42 +252,24 @@ class BaseCartesianGrid : public GridInterface {
     return m_globalId[id];
   }
 
-  [[nodiscard]] inline auto propertiesToBits(const GInt id) const -> GUint {
-    if(DEBUG_LEVEL >= Debug_Level::debug) {
-      checkBounds(id);
-      return m_properties.at(id).to_ullong();
-    }
-    return m_properties[id].to_ullong();
-  }
+  [[nodiscard]] inline auto propertiesToBits(const GInt id) const -> GUint { return properties(id).to_ullong(); }
 
-  void propertiesFromBits(const GInt id, const GUint bits) {
-    if(DEBUG_LEVEL >= Debug_Level::debug) {
-      checkBounds(id);
-    }
-    m_properties[id] = PropertyBitsetType(bits);
-  }
+  void propertiesFromBits(const GInt id, const GUint bits) { assignProperties(id, PropertyBitsetType(bits)); }
 
-  [[nodiscard]] inline auto propertiesToString(const GInt id) const -> GString {
-    if(DEBUG_LEVEL >= Debug_Level::debug) {
-      checkBounds(id);
-      return m_properties.at(id).to_string();
-    }
-    return m_properties[id].to_string();
-  }
+  [[nodiscard]] inline auto propertiesToString(const GInt id) const -> GString { return properties(id).to_string(); }
 
   void resetProperties(const GInt id) {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       checkBounds(id);
     }
-    m_properties[id].reset();
+    m_properties.reset(id, id + 1);
   }
 
   [[nodiscard]] inline auto isLeafCell(const GInt id) const -> GBool {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       checkBounds(id);
-      return m_properties.at(id)[static_cast<GInt>(CellProperties::leaf)];
     }
-    return m_properties[id][static_cast<GInt>(CellProperties::leaf)];
+    return m_properties(id, CellProperties::leaf);
   }
 
   void checkBounds(const GInt id) const {
@@ -315,9 +301,12 @@ class BaseCartesianGrid : public GridInterface {
     return m_parentId[id] > -1;
   }
 
-  [[nodiscard]] inline auto props() const -> const std::vector<PropertyBitsetType>& { return m_properties; }
+  [[nodiscard]] inline auto props() const -> const PropertyStorageType& { return m_properties; }
 
  protected:
+  /// Give write access to the properties, e.g., for scans over a range of cells.
+  inline auto props() -> PropertyStorageType& { return m_properties; }
+
   inline auto ref_currentHighestLvl() -> GInt& { return m_currentHighestLvl; }
   inline auto ref_currentHighestLvl() const -> const GInt& { return m_currentHighestLvl; }
 
@@ -334,7 +323,7 @@ class BaseCartesianGrid : public GridInterface {
     return m_parentId[id];
   }
 
-  inline auto center() -> std::vector<Point<NDIM>>& { return m_center; }
+  inline auto center() -> FirstTouchVector<Point<NDIM>>& { return m_center; }
 
   [[nodiscard]] inline auto center(const GInt id) -> Point<NDIM>& {
     if(DEBUG_LEVEL >= Debug_Level::debug) {
@@ -382,8 +371,14 @@ class BaseCartesianGrid : public GridInterface {
   inline auto geometry() const { return m_geometry; }
 
   void setCapacity(const GInt capacity) override {
-    m_properties.resize(capacity);
+    setCellCapacity(capacity);
     m_center.resize(capacity);
+  }
+
+  /// Allocate all cell data apart from the cell centers, for grids that derive the centers.
+  /// \param capacity Number of cells.
+  void setCellCapacity(const GInt capacity) {
+    m_properties.resize(capacity);
     m_parentId.resize(capacity);
     m_level.resize(capacity);
     m_globalId.resize(capacity);
@@ -391,13 +386,29 @@ class BaseCartesianGrid : public GridInterface {
   }
 
   void reset() override {
-    std::for_each(m_properties.begin(), m_properties.end(), [](auto& prop) { prop.reset(); });
-    std::fill(m_parentId.begin(), m_parentId.end(), INVALID_CELLID);
-    std::fill(m_level.begin(), m_level.end(), std::byte(-1));
-    std::fill(m_globalId.begin(), m_globalId.end(), INVALID_CELLID);
+    m_properties.reset(0, m_properties.capacity());
+    memory::parallelFill(m_parentId, 0, m_capacity, INVALID_CELLID);
+    memory::parallelFill(m_level, 0, m_capacity, std::byte(-1));
+    memory::parallelFill(m_globalId, 0, m_capacity, INVALID_CELLID);
     m_size = 0;
   }
 
+  /// Take over the cell data of another grid without copying it, e.g., the generated grid. The cell centers are only moved
+  /// if the other grid stores them. The other grid is empty afterwards.
+  /// \param other Grid of which the cell data is moved.
+  void moveCellData(BaseCartesianGrid&& other) {
+    m_properties = std::move(other.m_properties);
+    m_parentId   = std::move(other.m_parentId);
+    m_globalId   = std::move(other.m_globalId);
+    m_level      = std::move(other.m_level);
+    if(!other.m_center.empty()) {
+      m_center = std::move(other.m_center);
+    }
+    m_size     = other.m_size;
+    m_capacity = other.m_capacity;
+    other.clear();
+  }
+
   void clear() {
     m_properties.clear();
     m_parentId.clear();
@@ -444,11 +455,11 @@ class BaseCartesianGrid : public GridInterface {
   // length of the cells on each level basest on the largest extent
   std::array<GDouble, MAX_LVL> m_lengthOnLevel{NAN_LIST<MAX_LVL>()};
 
-  std::vector<PropertyBitsetType> m_properties{};
-  std::vector<GInt>               m_parentId{};
-  std::vector<GInt>               m_globalId{};
-  std::vector<Point<NDIM>>        m_center{};
-  std::vector<std::byte>          m_level{};
+  PropertyStorageType             m_properties{};
+  FirstTouchVector<GInt>          m_parentId{};
+  FirstTouchVector<GInt>          m_globalId{};
+  FirstTouchVector<Point<NDIM>>   m_center{};
+  FirstTouchVector<std::byte>     m_level{};
 };
 
 #endif // GRIDGENERATOR_BASE_CARTESIANGRID_H
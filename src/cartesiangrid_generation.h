@@ -3,8 +3,40 @@
 #include <sfcmm_common.h>
 #include "cartesiangrid_base.h"
 #include "common/IO.h"
+#include "loadbalancing_weights.h"
+#include "refinement_regions.h"
+
+/// Result of the count-only pass of the grid generation (see CartesianGridGen::predictGrid()).
+struct GridPrediction {
+  // number of cells of each level
+  std::vector<GInt> noCells{};
+  // number of boundary cells of each level
+  std::vector<GInt> noBndryCells{};
+  // number of cells of the final grid
+  GInt size = 0;
+  // number of leaf cells of the final grid
+  GInt noLeafCells = 0;
+  // capacity required to generate the grid
+  GInt capacity = 0;
+};
+
+/// Criterion of the feature-based refinement of the boundary cells (see CartesianGridGen::setFeatureRefinement()).
+struct FeatureRefinement {
+  // boundary cells of lower levels are always refined (disabled if negative)
+  GInt minLvl = -1;
+  // largest angle between the normals of the surface within a cell
+  GDouble normalAngle = PI;
+  // largest dihedral angle of the surface within a cell
+  GDouble dihedralAngle = PI;
+  // smallest number of cells per radius of curvature
+  GDouble cellsPerFeature = 0;
+};
 
-template <Debug_Level DEBUG_LEVEL, GInt NDIM>
+/// Generator of a cartesian grid refined towards the geometry.
+/// \tparam DEBUG_LEVEL Debug level.
+/// \tparam NDIM Number of dimensions.
+/// \tparam LAYOUT Layout policy of the cell connectivity (see CellLayout).
+template <Debug_Level DEBUG_LEVEL, GInt NDIM, typename LAYOUT = DefaultCellLayout>
 class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
  public:
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::partitionLvl;
@@ -16,18 +48,25 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::currentHighestLvl;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::geometry;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::property;
+  using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::properties;
+  using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::assignProperties;
+  using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::resetProperties;
+  using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::props;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::parent;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::level;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::globalId;
-  using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::center;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::empty;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::size;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::capacity;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::boundingBox;
   using BaseCartesianGrid<DEBUG_LEVEL, NDIM>::transformMaxLvl;
 
-  using PropertyBitsetType = grid::cell::BitsetType;
-  using ChildListType      = std::array<GInt, cartesian::maxNoChildren<NDIM>()>;
+  using PropertyBitsetType   = grid::cell::BitsetType;
+  using PropertyStorageType  = typename BaseCartesianGrid<DEBUG_LEVEL, NDIM>::PropertyStorageType;
+  using ChildListType        = std::array<GInt, cartesian::maxNoChildren<NDIM>()>;
+  using IndexType            = typename LAYOUT::IndexType;
+  using NeighborConnectivity = CellConnectivity<LAYOUT, cartesian::maxNoNghbrs<NDIM>()>;
+  using ChildConnectivity    = CellConnectivity<LAYOUT, cartesian::maxNoChildren<NDIM>()>;
 
   explicit CartesianGridGen(const GInt maxNoCells) { setCapacity(maxNoCells); }
   ~CartesianGridGen() override                                 = default;
@@ -45,23 +84,54 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
              << " but allocated " << capacity() << std::endl;
       return;
     }
-    m_noChildren.resize(_capacity);
-    m_nghbrIds.resize(_capacity);
-    m_childIds.resize(_capacity);
-    m_rfnDistance.resize(_capacity);
-    BaseCartesianGrid<DEBUG_LEVEL, NDIM>::setCapacity(_capacity);
+    if(_capacity > LAYOUT::maxNoCells()) {
+      TERMM(-1, "The capacity of " + std::to_string(_capacity) + " cells exceeds the cell ids of the grid layout (max. "
+                    + std::to_string(LAYOUT::maxNoCells()) + " cells), enable GRIDGEN_64BIT_CELLIDS.");
+    }
+    resizeCells(_capacity);
   }
 
+  /// Let the capacity grow on demand instead of terminating when the preallocated capacity is exceeded. The cell ids stay
+  /// valid when the storage grows.
+  /// \param maxCapacity Upper limit of the capacity (only limited by the cell ids of the layout if negative).
+  void setGrowable(const GInt maxCapacity) {
+    m_growable    = true;
+    m_maxCapacity = maxCapacity < 0 ? LAYOUT::maxNoCells() : std::min(maxCapacity, LAYOUT::maxNoCells());
+  }
+
+  /// Capacity is growing on demand.
+  [[nodiscard]] auto growable() const -> GBool { return m_growable; }
+
+  /// Refine the boundary cells from the minimum level on only where the surface is not resolved sufficiently, i.e., if the
+  /// surface within a cell bends more than the given angles or its radius of curvature is resolved by too few cells.
+  /// \param criterion Criterion of the feature-based refinement.
+  void setFeatureRefinement(const FeatureRefinement& criterion) { m_featureRefinement = criterion; }
+
   void reset() override {
     m_noChildren.clear();
     m_nghbrIds.clear();
     m_childIds.clear();
     m_rfnDistance.clear();
+    m_coordinate.clear();
+    m_refineOffsets.clear();
+    m_regionIds.clear();
+    m_newCellIds.clear();
+    m_partitionCellOffsets.clear();
+    m_domainOffsets.clear();
+    m_partitionCells.clear();
+    m_partitionOffsets.clear();
+    m_partitionDomains.clear();
+    m_cutElements             = {};
+    m_noSkippedGeometryChecks = 0;
     BaseCartesianGrid<DEBUG_LEVEL, NDIM>::clear();
   }
 
   void setMaxLvl(const GInt _maxLvl) override {
+    if(_maxLvl >= static_cast<GInt>(std::numeric_limits<typename CellCoordinate<NDIM>::value_type>::digits)) {
+      TERMM(-1, "The cell coordinates don't support level " + std::to_string(_maxLvl));
+    }
     m_levelOffsets.resize(_maxLvl + 1);
+    m_lvlOrigin.resize(_maxLvl + 1);
     BaseCartesianGrid<DEBUG_LEVEL, NDIM>::setMaxLvl(_maxLvl);
   }
 
@@ -102,14 +172,18 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
       m_levelOffsets[1] = {0, cartesian::maxNoChildren<NDIM>()};
     }
 
-    const GInt begin                       = m_levelOffsets[0].begin;
-    center(begin)                          = Point<NDIM>(cog().data());
+    // all levels share the lower corner of the initial cube
+    std::fill(m_lvlOrigin.begin(), m_lvlOrigin.end(), Point<NDIM>((Point<NDIM>(cog().data()).array() - HALF * lengthOnLvl(0)).matrix()));
+
+    const GInt begin = m_levelOffsets[0].begin;
+    m_coordinate[begin].fill(0);
     globalId(begin)                        = begin;
     property(begin, CellProperties::bndry) = true;
     size()                                 = 1;
 
     //  Refine to min level
     for(GInt l = 0; l < partitionLvl(); l++) {
+      preparePartitioningLevel(l);
       const GInt prevLevelBegin   = m_levelOffsets[l].begin;
       const GInt prevLevelEnd     = m_levelOffsets[l].end;
       const GInt prevLevelNoCells = prevLevelEnd - prevLevelBegin;
@@ -146,6 +220,57 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     RECORD_TIMER_STOP(TimeKeeper[Timers::GridPart]);
   }
 
+  /// Distribute the partitioning grid among the MPI ranks. Each rank owns a contiguous range of the Hilbert ordered
+  /// partitioning cells and keeps the cells of other ranks which are face neighbors of its own cells as halo cells. The
+  /// halo cells are refined along with the own cells, but only a single layer of halo cells is kept on each level.
+  void distributePartitioningGrid() {
+    ASSERT(m_levelOffsets[partitionLvl()].begin == 0, "Partitioning grid is not at the beginning!");
+    const GInt noPartitionCells = levelSize(m_levelOffsets[partitionLvl()]);
+    const GInt noDomains        = MPI::globalNoDomains();
+    if(noPartitionCells < noDomains) {
+      TERMM(-1, "Not enough partitioning cells (" + std::to_string(noPartitionCells) + ") for " + std::to_string(noDomains)
+                    + " domains! Increase the partitionLevel.");
+    }
+
+    // the partitioning cells are distributed equally along the Hilbert curve
+    m_domainOffsets.resize(noDomains + 1);
+    for(GInt domainId = 0; domainId <= noDomains; ++domainId) {
+      m_domainOffsets[domainId] = domainId * noPartitionCells / noDomains;
+    }
+    // the global id of the partitioning cells is their position on the Hilbert curve
+    std::iota(&globalId(0), &globalId(0) + noPartitionCells, 0);
+    if(MPI::isSerial()) {
+      return;
+    }
+
+    const GInt firstLocalCell = m_domainOffsets[MPI::globalDomainId()];
+    const GInt lastLocalCell  = m_domainOffsets[MPI::globalDomainId() + 1];
+    const auto isLocal        = [&](const GInt cellId) { return cellId >= firstLocalCell && cellId < lastLocalCell; };
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(noPartitionCells, isLocal)
+#endif
+    for(GInt cellId = 0; cellId < noPartitionCells; ++cellId) {
+      GBool keep = isLocal(cellId);
+      for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>() && !keep; ++dir) {
+        const GInt nghbrId = m_nghbrIds(cellId, dir);
+        keep               = nghbrId != INVALID_CELLID && isLocal(nghbrId);
+      }
+      property(cellId, CellProperties::halo)   = !isLocal(cellId);
+      property(cellId, CellProperties::inside) = keep;
+      property(cellId, CellProperties::bndry)  = keep && property(cellId, CellProperties::bndry);
+    }
+    compactLevel(partitionLvl());
+    size() = levelSize(m_levelOffsets[partitionLvl()]);
+
+    logger << SP2 << "+ domain " << MPI::globalDomainId() << " owns " << lastLocalCell - firstLocalCell << " of " << noPartitionCells
+           << " partitioning cells (" << size() - (lastLocalCell - firstLocalCell) << " halo cells)" << std::endl;
+    std::cout << SP2 << "+ domain " << MPI::globalDomainId() << " owns " << lastLocalCell - firstLocalCell << " of "
+              << noPartitionCells << " partitioning cells (" << size() - (lastLocalCell - firstLocalCell) << " halo cells)" << std::endl;
+  }
+
+  /// Range of the partitioning cells along the Hilbert curve that are owned by each domain (noDomains + 1 entries).
+  [[nodiscard]] auto domainOffsets() const -> const std::vector<GInt>& { return m_domainOffsets; }
+
   /// Uniformly refine the grid up to the provided level.
   /// \param uniformLvl Level of uniform refinement.
   void uniformRefineGrid(const GInt uniformLevel) {
@@ -159,11 +284,9 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
 
     for(GInt lvl = partitionLvl(); lvl < uniformLevel; lvl++) {
       m_levelOffsets[lvl + 1] = {size(), size() + levelSize(m_levelOffsets[lvl]) * cartesian::maxNoChildren<NDIM>()};
-      if(m_levelOffsets[lvl + 1].end > capacity()) {
-        outOfMemory(lvl + 1);
-      }
+      reserveCells(m_levelOffsets[lvl + 1].end, lvl + 1);
 
-      refineGrid<true>(lvl);
+      refineGrid(lvl);
     }
     RECORD_TIMER_STOP(TimeKeeper[Timers::GridUniform]);
   }
@@ -180,24 +303,215 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     std::cout << SP1 << "Refining marked cells to level " << currentHighestLvl() + 1 << std::endl;
     // update the offsets
     m_levelOffsets[currentHighestLvl() + 1] = {size(), size() + noCellsToRefine * cartesian::maxNoChildren<NDIM>()};
-    if(m_levelOffsets[currentHighestLvl() + 1].end > capacity()) {
-      outOfMemory(currentHighestLvl() + 1);
-    }
+    reserveCells(m_levelOffsets[currentHighestLvl() + 1].end, currentHighestLvl() + 1);
     logger << SP2 << "* cells to refine: " << noCellsToRefine << std::endl;
     std::cout << SP2 << "* cells to refine: " << noCellsToRefine << std::endl;
 
 
-    refineGrid<true, false>(currentHighestLvl());
+    refineGrid<false>(currentHighestLvl());
+  }
+
+  /// Predict the grid without generating it. The cells are classified level by level in the same way as during the
+  /// generation, but only the integer coordinates of the boundary cells are stored, since the children of inner cells are
+  /// always inner cells. Non-boundary cells are checked individually instead of once per connected region, which only
+  /// differs for geometries with an ambiguous inside check. No cell storage is required and the capacity that the
+  /// generation requires is determined.
+  /// \param partitioningLvl Level of the partitioning grid.
+  /// \param uniformLvl Level up to which the grid is refined uniformly.
+  /// \return Number of cells of each level and the required capacity.
+  [[nodiscard]] auto predictGrid(const GInt partitioningLvl, const GInt uniformLvl) const -> GridPrediction {
+    static constexpr GUchar outside    = 0;
+    static constexpr GUchar inner      = 1;
+    static constexpr GUchar bndry      = 2;
+    static constexpr GInt   noChildren = cartesian::maxNoChildren<NDIM>();
+
+    const Point<NDIM> origin = (Point<NDIM>(cog().data()).array() - HALF * lengthOnLvl(0)).matrix();
+
+    GridPrediction prediction;
+    prediction.noCells.assign(maxLvl() + 1, 0);
+    prediction.noBndryCells.assign(maxLvl() + 1, 0);
+    // the initial cube is always a boundary cell
+    std::vector<CellCoordinate<NDIM>> bndryCells(1);
+    bndryCells[0].fill(0);
+    GInt noInnerCells = 0;
+
+    for(GInt lvl = 0; lvl <= maxLvl(); ++lvl) {
+      const GInt noBndryCells      = bndryCells.size();
+      prediction.noCells[lvl]      = noInnerCells + noBndryCells;
+      prediction.noBndryCells[lvl] = noBndryCells;
+      // the levels below the partitioning level are replaced by the partitioning grid
+      if(lvl >= partitioningLvl) {
+        prediction.size += prediction.noCells[lvl];
+      }
+      if(lvl == maxLvl()) {
+        prediction.noLeafCells += prediction.noCells[lvl];
+        break;
+      }
+      // the inner cells are only refined below the uniform level
+      if(lvl >= uniformLvl) {
+        prediction.noLeafCells += noInnerCells;
+      }
+
+      // storage required for the children (see createPartitioningGrid(), uniformRefineGrid() and refineMarkedCells())
+      const GBool uniform = lvl < uniformLvl;
+      if(lvl < partitioningLvl) {
+        prediction.capacity = std::max(prediction.capacity, prediction.noCells[lvl] * (1 + noChildren));
+      } else {
+        const GInt noRefinedCells = uniform ? prediction.noCells[lvl] : noBndryCells;
+        prediction.capacity       = std::max(prediction.capacity, prediction.size + noRefinedCells * noChildren);
+      }
+
+      // classify the children of the boundary cells
+      const GDouble       childLength = lengthOnLvl(lvl + 1);
+      std::vector<GUchar> childState(noBndryCells * noChildren);
+      const auto&         childDir = cartesian::childDir;
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(noBndryCells, bndryCells, childState, childLength, origin, childDir) schedule(dynamic, 64)
+#endif
+      for(GInt id = 0; id < noBndryCells * noChildren; ++id) {
+        const GInt  childId = id % noChildren;
+        Point<NDIM> center;
+        for(GInt dir = 0; dir < NDIM; ++dir) {
+          const GUint32 coordinate = 2 * bndryCells[id / noChildren][dir] + static_cast<GUint32>(childDir[childId][dir] > 0);
+          center[dir]              = origin[dir] + (static_cast<GDouble>(coordinate) + HALF) * childLength;
+        }
+        if(geometry()->cutWithCell(center, childLength)) {
+          childState[id] = bndry;
+        } else {
+          childState[id] = pointIsInside(center) ? inner : outside;
+        }
+      }
+
+      // only inner cells are refined uniformly
+      noInnerCells = uniform ? noInnerCells * noChildren : 0;
+      for(const GUchar state : childState) {
+        noInnerCells += static_cast<GInt>(state == inner);
+      }
+
+      std::vector<GInt> childOffsets;
+      const GInt        noChildBndryCells =
+          algorithm::exclusiveScan(noBndryCells * noChildren, [&](const GInt id) { return GInt(childState[id] == bndry); }, childOffsets);
+      std::vector<CellCoordinate<NDIM>> childBndryCells(noChildBndryCells);
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(noBndryCells, bndryCells, childBndryCells, childState, childOffsets, childDir)
+#endif
+      for(GInt id = 0; id < noBndryCells * noChildren; ++id) {
+        if(childState[id] == bndry) {
+          for(GInt dir = 0; dir < NDIM; ++dir) {
+            childBndryCells[childOffsets[id]][dir] =
+                2 * bndryCells[id / noChildren][dir] + static_cast<GUint32>(childDir[id % noChildren][dir] > 0);
+          }
+        }
+      }
+      bndryCells = std::move(childBndryCells);
+    }
+    return prediction;
   }
 
-  /// Mark all boundary cells for refinement
+  /// Mark all boundary cells and the cells within a distance of rfnDistance cells of the same level for refinement. The
+  /// distance to the boundary is determined by a breadth-first wavefront along the neighbors starting at the boundary
+  /// cells, i.e., no further geometry queries are required. On a distributed grid the halo cells receive their distance
+  /// from the domain owning them after each step of the wavefront.
+  /// \param rfnDistance Width of the band of cells around the boundary.
   /// \return Number of cells marked for refinement
-  auto markBndryCells() -> GInt {
+  auto markBndryCells(const GInt rfnDistance = 0) -> GInt {
     logger << SP2 << "* marking bndry cells " << std::endl;
     std::cout << SP2 << "* marking bndry cells " << std::endl;
-    GInt markedCells = 0;
-    for(GInt cellId = m_levelOffsets[currentHighestLvl()].begin; cellId < m_levelOffsets[currentHighestLvl()].end; ++cellId) {
-      if(property(cellId, CellProperties::bndry)) {
+    const GInt firstCell   = m_levelOffsets[currentHighestLvl()].begin;
+    const GInt lastCell    = m_levelOffsets[currentHighestLvl()].end;
+    GInt       markedCells = 0;
+
+    // the features of the surface are given by the elements cutting the cells
+    const GBool featureBased = m_featureRefinement.minLvl >= 0 && currentHighestLvl() >= m_featureRefinement.minLvl;
+    if(featureBased) {
+      updateCutElements(currentHighestLvl());
+    }
+    const auto isSeed = [&](const GInt cellId) {
+      return property(cellId, CellProperties::bndry) && (!featureBased || surfaceUnresolved(cellId));
+    };
+
+    if(rfnDistance <= 0 && !featureBased) {
+      // all boundary cells are refined, i.e., the property is copied word-wise
+      markedCells = props().count(CellProperties::bndry, firstCell, lastCell);
+      props().setWhere(CellProperties::toRefine, CellProperties::bndry, firstCell, lastCell);
+      return markedCells;
+    }
+    if(rfnDistance <= 0) {
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstCell, lastCell, isSeed) reduction(+ : markedCells) schedule(dynamic, 64)
+#endif
+      for(GInt cellId = firstCell; cellId < lastCell; ++cellId) {
+        if(isSeed(cellId)) {
+          property(cellId, CellProperties::toRefine) = true;
+          markedCells++;
+        }
+      }
+      logFeatureRefinement(featureBased, markedCells);
+      return markedCells;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstCell, lastCell, isSeed) schedule(dynamic, 64)
+#endif
+    for(GInt cellId = firstCell; cellId < lastCell; ++cellId) {
+      m_rfnDistance[cellId] = isSeed(cellId) ? 0 : -1;
+    }
+    std::vector<GInt> front;
+    for(GInt cellId = firstCell; cellId < lastCell; ++cellId) {
+      if(m_rfnDistance[cellId] == 0) {
+        front.emplace_back(cellId);
+      }
+    }
+    logFeatureRefinement(featureBased, static_cast<GInt>(front.size()));
+    const HaloExchange exchange = distributed() ? setupHaloExchange(firstCell, lastCell) : HaloExchange{};
+
+    for(GInt distance = 1; distance <= rfnDistance; ++distance) {
+      // collect the unvisited neighbors of the front, the distance of the halo cells is set by their domain
+      std::vector<GInt> candidates;
+#ifdef _OPENMP
+#pragma omp parallel default(none) shared(front, candidates)
+#endif
+      {
+        std::vector<GInt> threadCandidates;
+#ifdef _OPENMP
+#pragma omp for schedule(static) nowait
+#endif
+        for(GUint id = 0; id < front.size(); ++id) {
+          for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>(); ++dir) {
+            const GInt nghbrId = m_nghbrIds(front[id], dir);
+            if(nghbrId != INVALID_CELLID && m_rfnDistance[nghbrId] < 0 && !property(nghbrId, CellProperties::halo)) {
+              threadCandidates.emplace_back(nghbrId);
+            }
+          }
+        }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        candidates.insert(candidates.end(), threadCandidates.begin(), threadCandidates.end());
+      }
+
+      front.clear();
+      for(const GInt cellId : candidates) {
+        if(m_rfnDistance[cellId] < 0) {
+          m_rfnDistance[cellId] = distance;
+          front.emplace_back(cellId);
+        }
+      }
+      if(distributed()) {
+        exchangeHaloData(exchange, [&](const GInt cellId) -> GInt& { return m_rfnDistance[cellId]; });
+        for(const GInt cellId : exchange.haloCells) {
+          if(m_rfnDistance[cellId] == distance) {
+            front.emplace_back(cellId);
+          }
+        }
+      }
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstCell, lastCell) reduction(+ : markedCells)
+#endif
+    for(GInt cellId = firstCell; cellId < lastCell; ++cellId) {
+      if(m_rfnDistance[cellId] >= 0) {
         property(cellId, CellProperties::toRefine) = true;
         markedCells++;
       }
@@ -205,6 +519,435 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     return markedCells;
   }
 
+  /// Mark the cells of the current highest level intersecting a refinement region whose level has not been reached yet.
+  /// The regions are checked top-down starting at the partitioning cells and a subtree is skipped as soon as none of the
+  /// regions intersects its root, i.e., only the cells close to the regions are checked. Regions that can't prune (see
+  /// RefinementRegion::canPrune()) are only checked for the cells of the current highest level. The halo cells are marked
+  /// in the same way as the cells of the domain.
+  /// \param regions Refinement regions.
+  /// \return Number of additionally marked cells.
+  auto markRegionCells(const std::vector<std::unique_ptr<RefinementRegion<NDIM>>>& regions) -> GInt {
+    std::vector<const RefinementRegion<NDIM>*> activeRegions;
+    for(const auto& region : regions) {
+      if(region->level() > currentHighestLvl()) {
+        activeRegions.emplace_back(region.get());
+      }
+    }
+    if(activeRegions.empty()) {
+      return 0;
+    }
+    logger << SP2 << "* marking cells of " << activeRegions.size() << " refinement regions" << std::endl;
+    std::cout << SP2 << "* marking cells of " << activeRegions.size() << " refinement regions" << std::endl;
+
+    const GInt firstRoot    = m_levelOffsets[partitionLvl()].begin;
+    const GInt lastRoot     = m_levelOffsets[partitionLvl()].end;
+    GInt       markedCells  = 0;
+    GInt       checkedCells = 0;
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstRoot, lastRoot, activeRegions) reduction(+ : markedCells, checkedCells) \
+    schedule(dynamic, 16)
+#endif
+    for(GInt cellId = firstRoot; cellId < lastRoot; ++cellId) {
+      markedCells += markRegionSubtree(cellId, activeRegions, checkedCells);
+    }
+    logger << SP3 << "* checked " << checkedCells << " of " << size() << " cells, marked " << markedCells << " additional cells"
+           << std::endl;
+    return markedCells;
+  }
+
+  /// Mark the cells of the current highest level for which the refinement criterion is positive. The criterion is an
+  /// expression of the cell center (x, y, z) and the level, which each thread evaluates with its own compiled instance for
+  /// batches of consecutive cells.
+  /// \param criterion Refinement criterion with the level as its only additional parameter.
+  /// \return Number of additionally marked cells.
+  auto markCriterionCells(const ThreadMathExpression<NDIM>& criterion) -> GInt {
+    static constexpr GInt batchSize = 256;
+    logger << SP2 << "* marking cells of the refinement criterion" << std::endl;
+    std::cout << SP2 << "* marking cells of the refinement criterion" << std::endl;
+
+    const GInt firstCell   = m_levelOffsets[currentHighestLvl()].begin;
+    const GInt lastCell    = m_levelOffsets[currentHighestLvl()].end;
+    GInt       markedCells = 0;
+#ifdef _OPENMP
+#pragma omp parallel default(none) shared(criterion, firstCell, lastCell) reduction(+ : markedCells)
+#endif
+    {
+      MathExpression<NDIM>& expression = criterion.local();
+      expression.parameter(0)          = static_cast<GDouble>(currentHighestLvl());
+      std::array<Point<NDIM>, batchSize> centers;
+      std::array<GDouble, batchSize>     values{};
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for(GInt firstOfBatch = firstCell; firstOfBatch < lastCell; firstOfBatch += batchSize) {
+        const GInt noCells = std::min(static_cast<GInt>(batchSize), lastCell - firstOfBatch);
+        for(GInt id = 0; id < noCells; ++id) {
+          centers[id] = center(firstOfBatch + id);
+        }
+        expression.eval(noCells, centers.data(), values.data());
+        for(GInt id = 0; id < noCells; ++id) {
+          const GInt cellId = firstOfBatch + id;
+          if(values[id] > 0 && !property(cellId, CellProperties::toRefine)) {
+            property(cellId, CellProperties::toRefine) = true;
+            ++markedCells;
+          }
+        }
+      }
+    }
+    logger << SP3 << "* marked " << markedCells << " additional cells" << std::endl;
+    return markedCells;
+  }
+
+  /// Enforce a 2:1 balance of the levels before the marked cells of the current highest level are refined, i.e., the
+  /// levels of neighboring leaf cells differ by at most one. The children of a refined cell need the neighbors of its
+  /// level, hence, the leaf cells of the lower levels in front of a refined cell are marked as well. The marking ripples
+  /// down the levels in parallel sweeps until no further cells are marked, which requires a balanced grid before, i.e.,
+  /// this needs to be done before each refinement. The marked leaf cells are refined and the levels are rearranged to
+  /// keep the cells of each level contiguous. Boundary leaf cells remain with the feature refinement, their children are
+  /// classified and the outside children are removed (see refineLeafCells()). On a distributed grid the marks of the halo
+  /// cells are received from the domain owning them after each sweep.
+  /// \return Number of refined leaf cells.
+  auto balanceLevels() -> GInt {
+    logger << SP2 << "* balancing levels " << std::endl;
+    std::cout << SP2 << "* balancing levels " << std::endl;
+    const GInt highestLvl = currentHighestLvl();
+
+    std::vector<GInt> marked(size(), 0);
+    std::vector<GInt> front;
+    props().forEach(CellProperties::toRefine, m_levelOffsets[highestLvl].begin, m_levelOffsets[highestLvl].end,
+                    [&](const GInt cellId) { front.emplace_back(cellId); });
+    const HaloExchange exchange = distributed() ? setupHaloExchange(0, size()) : HaloExchange{};
+
+    GInt noSweeps = 0;
+    for(GInt noFrontCells = 1; noFrontCells > 0; ++noSweeps) {
+      std::vector<GInt> nextFront;
+#ifdef _OPENMP
+#pragma omp parallel default(none) shared(front, marked, nextFront)
+#endif
+      {
+        std::vector<GInt> threadFront;
+#ifdef _OPENMP
+#pragma omp for schedule(static) nowait
+#endif
+        for(GUint id = 0; id < front.size(); ++id) {
+          const GInt cellId   = front[id];
+          const GInt parentId = parent(cellId);
+          for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>() && parentId != INVALID_CELLID; ++dir) {
+            // only missing neighbors outside of the parent can be covered by a leaf cell of the parent level
+            if(m_nghbrIds(cellId, dir) != INVALID_CELLID || (m_coordinate[cellId][dir / 2] & 1U) != static_cast<GUint32>(dir % 2)) {
+              continue;
+            }
+            const GInt nghbrId = m_nghbrIds(parentId, dir);
+            if(nghbrId == INVALID_CELLID || m_noChildren[nghbrId] > 0 || property(nghbrId, CellProperties::halo)) {
+              continue;
+            }
+            GInt wasMarked = 0;
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+            {
+              wasMarked       = marked[nghbrId];
+              marked[nghbrId] = 1;
+            }
+            if(wasMarked == 0) {
+              threadFront.emplace_back(nghbrId);
+            }
+          }
+        }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        nextFront.insert(nextFront.end(), threadFront.begin(), threadFront.end());
+      }
+
+      if(distributed()) {
+        std::vector<GInt> haloMarked(exchange.haloCells.size());
+        for(GUint id = 0; id < exchange.haloCells.size(); ++id) {
+          haloMarked[id] = marked[exchange.haloCells[id]];
+        }
+        exchangeHaloData(exchange, [&](const GInt cellId) -> GInt& { return marked[cellId]; });
+        for(GUint id = 0; id < exchange.haloCells.size(); ++id) {
+          const GInt cellId = exchange.haloCells[id];
+          marked[cellId]    = std::max(marked[cellId], GInt(0));
+          if(haloMarked[id] == 0 && marked[cellId] == 1) {
+            nextFront.emplace_back(cellId);
+          }
+        }
+      }
+      front        = std::move(nextFront);
+      noFrontCells = static_cast<GInt>(front.size());
+      if(distributed()) {
+        MPI_Allreduce(MPI_IN_PLACE, &noFrontCells, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+      }
+    }
+
+    std::vector<GInt> leafCells;
+    for(GInt cellId = 0; cellId < size(); ++cellId) {
+      if(marked[cellId] == 1) {
+        leafCells.emplace_back(cellId);
+      }
+    }
+    GInt noLeafCells = static_cast<GInt>(leafCells.size());
+    if(distributed()) {
+      MPI_Allreduce(MPI_IN_PLACE, &noLeafCells, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+    }
+    logger << SP3 << "* refining " << noLeafCells << " leaf cells of lower levels (" << noSweeps << " sweeps)" << std::endl;
+    std::cout << SP3 << "* refining " << noLeafCells << " leaf cells of lower levels (" << noSweeps << " sweeps)" << std::endl;
+    if(leafCells.empty()) {
+      return 0;
+    }
+    refineLeafCells(leafCells);
+    return static_cast<GInt>(leafCells.size());
+  }
+
+  /// Partition the grid into domains of equal workload along the Hilbert curve. The number of offsprings and the workload
+  /// of the subtree of each cell are accumulated bottom-up. Partitioning cells exceeding one of the limits are replaced by
+  /// their children (and marked as partitionLevelShifted), which is repeated on the following levels. The own workload of
+  /// a replaced cell is added to its first partition cell. Afterwards, the Hilbert curve of the partition cells is cut
+  /// into ranges of equal workload. The partition cells and the domain of each cell can be written with the grid (output
+  /// values "partitionCell" and "domain", see save()). Requires valid level offsets, i.e., needs to be called before
+  /// reorderDepthFirstHilbert().
+  /// \param weightMethod Workload of the cells.
+  /// \param maxNoOffsprings Maximum number of cells in the subtree of a partition cell.
+  /// \param maxOffspringWorkload Maximum workload of the subtree of a partition cell.
+  /// \param noDomains Number of domains.
+  void partitionGrid(const WeightMethod& weightMethod, const GInt maxNoOffsprings, const GDouble maxOffspringWorkload,
+                     const GInt noDomains) {
+    logger << SP1 << "Partitioning grid for " << noDomains << " domains" << std::endl;
+    std::cout << SP1 << "Partitioning grid for " << noDomains << " domains" << std::endl;
+    ASSERT(m_levelOffsets[partitionLvl()].begin == 0, "Partitioning grid is not at the beginning!");
+
+    // halo cells are accounted for by the domain owning them
+    std::vector<GInt>    noOffsprings(size());
+    std::vector<GDouble> workload(size());
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(weightMethod, noOffsprings, workload)
+#endif
+    for(GInt cellId = 0; cellId < size(); ++cellId) {
+      const GBool halo = property(cellId, CellProperties::halo);
+      noOffsprings[cellId] = halo ? 0 : 1;
+      workload[cellId]     = halo ? 0.0 : weightMethod.weight(properties(cellId), std::to_integer<GInt>(level(cellId)));
+      property(cellId, CellProperties::partitionCell)         = false;
+      property(cellId, CellProperties::partitionLevelShifted) = false;
+    }
+    accumulateSubtrees(noOffsprings);
+    accumulateSubtrees(workload);
+
+    // replace the oversized partition cells along the Hilbert curve
+    std::vector<GInt> remainingCells;
+    for(GInt cellId = m_levelOffsets[partitionLvl()].end - 1; cellId >= 0; --cellId) {
+      if(!property(cellId, CellProperties::halo)) {
+        remainingCells.emplace_back(cellId);
+      }
+    }
+    m_partitionCells.clear();
+    std::vector<GDouble> partitionWorkload;
+    GInt                 noShiftedCells  = 0;
+    GDouble              shiftedWorkload = 0.0;
+    while(!remainingCells.empty()) {
+      const GInt cellId = remainingCells.back();
+      remainingCells.pop_back();
+      if((noOffsprings[cellId] > maxNoOffsprings || workload[cellId] > maxOffspringWorkload) && m_noChildren[cellId] > 0) {
+        shiftedWorkload += weightMethod.weight(properties(cellId), std::to_integer<GInt>(level(cellId)));
+        property(cellId, CellProperties::partitionLevelShifted) = true;
+        ++noShiftedCells;
+
+        ChildListType children;
+        for(GInt childId = hilbertOrderedChildren(cellId, children) - 1; childId >= 0; --childId) {
+          remainingCells.emplace_back(children[childId]);
+        }
+        continue;
+      }
+      property(cellId, CellProperties::partitionCell) = true;
+      m_partitionCells.emplace_back(cellId);
+      partitionWorkload.emplace_back(workload[cellId] + shiftedWorkload);
+      shiftedWorkload = 0.0;
+    }
+
+    // the partition cells of the domains are consecutive along the Hilbert curve
+    const GInt noLocalPartitionCells = static_cast<GInt>(m_partitionCells.size());
+    GDouble    localWorkload         = std::accumulate(partitionWorkload.begin(), partitionWorkload.end(), 0.0);
+    GDouble    workloadOffset        = 0.0;
+    GDouble    totalWorkload         = localWorkload;
+    GInt       noPartitionCells      = noLocalPartitionCells;
+    if(distributed()) {
+      MPI_Exscan(&localWorkload, &workloadOffset, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      if(MPI::isRoot()) {
+        workloadOffset = 0.0;
+      }
+      MPI_Allreduce(&localWorkload, &totalWorkload, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      MPI_Allreduce(MPI_IN_PLACE, &noPartitionCells, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+      MPI_Allreduce(MPI_IN_PLACE, &noShiftedCells, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+    }
+    m_partitionOffsets.resize(noDomains + 1);
+    algorithm::partitionCurve(noLocalPartitionCells, partitionWorkload.data(), noDomains, m_partitionOffsets.data(), workloadOffset,
+                              totalWorkload);
+
+    std::vector<GDouble> domainWorkload(noDomains, 0.0);
+    m_partitionDomains.resize(noLocalPartitionCells);
+    for(GInt domainId = 0; domainId < noDomains; ++domainId) {
+      domainWorkload[domainId] = std::accumulate(partitionWorkload.begin() + m_partitionOffsets[domainId],
+                                                 partitionWorkload.begin() + m_partitionOffsets[domainId + 1], 0.0);
+      std::fill(m_partitionDomains.begin() + m_partitionOffsets[domainId], m_partitionDomains.begin() + m_partitionOffsets[domainId + 1],
+                domainId);
+    }
+    if(distributed()) {
+      MPI_Allreduce(MPI_IN_PLACE, m_partitionOffsets.data(), static_cast<int>(noDomains + 1), MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+      MPI_Allreduce(MPI_IN_PLACE, domainWorkload.data(), static_cast<int>(noDomains), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    }
+
+    const auto [minWorkload, maxWorkload] = std::minmax_element(domainWorkload.begin(), domainWorkload.end());
+    const GDouble meanWorkload            = totalWorkload / static_cast<GDouble>(noDomains);
+    logger << SP2 << "+ partition cells: " << noPartitionCells << " (" << noShiftedCells << " cells replaced by their children)"
+           << std::endl;
+    std::cout << SP2 << "+ partition cells: " << noPartitionCells << " (" << noShiftedCells << " cells replaced by their children)"
+              << std::endl;
+    logger << SP2 << "+ workload per domain: min " << *minWorkload << " max " << *maxWorkload << " mean " << meanWorkload
+           << " imbalance " << *maxWorkload / meanWorkload << std::endl;
+    std::cout << SP2 << "+ workload per domain: min " << *minWorkload << " max " << *maxWorkload << " mean " << meanWorkload
+              << " imbalance " << *maxWorkload / meanWorkload << std::endl;
+    if(noPartitionCells < noDomains) {
+      logger << "WARNING: Less partition cells than domains! Decrease maxNoOffsprings or maxOffspringWorkload." << std::endl;
+      cerr0 << "WARNING: Less partition cells than domains! Decrease maxNoOffsprings or maxOffspringWorkload." << std::endl;
+    }
+  }
+
+  /// Partition cells of this domain along the Hilbert curve (see partitionGrid()).
+  [[nodiscard]] auto partitionCells() const -> const std::vector<GInt>& { return m_partitionCells; }
+
+  /// Range of the partition cells along the Hilbert curve that belong to each domain of the partitioned grid
+  /// (noDomains + 1 entries).
+  [[nodiscard]] auto partitionOffsets() const -> const std::vector<GInt>& { return m_partitionOffsets; }
+
+  /// Domain of each cell of the partitioned grid given by the partition cell of its subtree. The replaced partitioning
+  /// cells (see partitionGrid()) and cells of a grid that has not been partitioned belong to no domain (-1).
+  /// \return Domain of each cell.
+  [[nodiscard]] auto cellDomains() const -> std::vector<GInt> {
+    std::vector<GInt> domains(size(), -1);
+    for(GUint id = 0; id < m_partitionCells.size(); ++id) {
+      domains[m_partitionCells[id]] = m_partitionDomains[id];
+    }
+    // the parents are in front of their children in the level-wise as well as the depth-first order
+    for(GInt cellId = 0; cellId < size(); ++cellId) {
+      if(domains[cellId] == -1 && parent(cellId) != INVALID_CELLID && !property(cellId, CellProperties::halo)) {
+        domains[cellId] = domains[parent(cellId)];
+      }
+    }
+    return domains;
+  }
+
+  /// Reorder the whole grid depth-first along the Hilbert curve, i.e., each cell is directly followed by its subtree and
+  /// the subtrees are ordered as the partitioning cells. The range of the subtree of each partitioning cell is stored in
+  /// partitionCellOffsets(). Since the cells of a level are no longer contiguous the level offsets are invalidated, hence,
+  /// this needs to be the last step of the grid generation.
+  void reorderDepthFirstHilbert() {
+    logger << SP1 << "Reordering grid depth-first along the Hilbert curve" << std::endl;
+    std::cout << SP1 << "Reordering grid depth-first along the Hilbert curve" << std::endl;
+    ASSERT(m_levelOffsets[partitionLvl()].begin == 0, "Partitioning grid is not at the beginning!");
+
+    // size of the subtree of each cell including the cell itself
+    std::vector<GInt> noOffsprings(size(), 1);
+    accumulateSubtrees(noOffsprings);
+
+    // the subtrees of the partitioning cells keep the Hilbert order of the partitioning grid
+    const GInt noPartitionCells = levelSize(m_levelOffsets[partitionLvl()]);
+    const GInt noCells =
+        algorithm::exclusiveScan(noPartitionCells, [&](const GInt cellId) { return noOffsprings[cellId]; }, m_partitionCellOffsets);
+    ASSERT(noCells == size(), "Invalid number of cells in the subtrees!");
+    m_partitionCellOffsets.emplace_back(noCells);
+
+    m_newCellIds.resize(size());
+    std::copy_n(m_partitionCellOffsets.begin(), noPartitionCells, m_newCellIds.begin());
+
+    // children follow their parent in the order of the Hilbert curve
+    for(GInt lvl = partitionLvl(); lvl < currentHighestLvl(); ++lvl) {
+      const GInt firstCellOfLvl = m_levelOffsets[lvl].begin;
+      const GInt lastCellOfLvl  = m_levelOffsets[lvl].end;
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstCellOfLvl, lastCellOfLvl, noOffsprings)
+#endif
+      for(GInt cellId = firstCellOfLvl; cellId < lastCellOfLvl; ++cellId) {
+        ChildListType children;
+        const GInt    noChildren = hilbertOrderedChildren(cellId, children);
+
+        GInt offset = m_newCellIds[cellId] + 1;
+        for(GInt childId = 0; childId < noChildren; ++childId) {
+          m_newCellIds[children[childId]] = offset;
+          offset += noOffsprings[children[childId]];
+        }
+      }
+    }
+
+    for(GInt& cellId : m_partitionCells) {
+      cellId = m_newCellIds[cellId];
+    }
+    reorderCells(0, size(), size());
+    std::fill(m_levelOffsets.begin(), m_levelOffsets.end(), LevelOffsetType{INVALID_CELLID, INVALID_CELLID});
+
+    if(DEBUG_LEVEL > Debug_Level::debug) {
+      for(GInt cellId = 0; cellId < size(); ++cellId) {
+        if(parent(cellId) >= cellId) {
+          TERMM(-1, "Cell " + std::to_string(cellId) + " is not behind its parent " + std::to_string(parent(cellId)));
+        }
+      }
+    }
+  }
+
+  /// Range of the subtree of each partitioning cell after reorderDepthFirstHilbert() (noPartitionCells + 1 entries).
+  [[nodiscard]] auto partitionCellOffsets() const -> const std::vector<GInt>& { return m_partitionCellOffsets; }
+
+  /// Number the cells of all domains consecutively, i.e., the cells of a domain follow the cells of the previous domain
+  /// in their local order. The cells of a domain which are adjacent to halo cells are marked as window cells and the
+  /// global ids of the halo cells are requested from the domain owning them. This needs to be the last step of the grid
+  /// generation.
+  void setGlobalIds() {
+    if(!distributed()) {
+      std::iota(&globalId(0), &globalId(0) + size(), 0);
+      return;
+    }
+    const auto isHalo = [&](const GInt cellId) { return property(cellId, CellProperties::halo); };
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(isHalo)
+#endif
+    for(GInt cellId = 0; cellId < size(); ++cellId) {
+      GBool window = false;
+      for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>() && !window && !isHalo(cellId); ++dir) {
+        window = adjacentTo(cellId, dir, isHalo);
+      }
+      property(cellId, CellProperties::window) = window;
+    }
+    // the domain of the halo cells is determined by the global ids of the partitioning cells
+    const HaloExchange exchange = setupHaloExchange(0, size());
+
+    // consecutive numbering of the cells of the domains
+    std::vector<GInt> localIds;
+    const GInt        noLocalCells = algorithm::exclusiveScan(size(), [&](const GInt cellId) { return GInt(!isHalo(cellId)); }, localIds);
+    GInt              offset       = 0;
+    MPI_Exscan(&noLocalCells, &offset, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+    if(MPI::isRoot()) {
+      offset = 0;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(isHalo, localIds, offset)
+#endif
+    for(GInt cellId = 0; cellId < size(); ++cellId) {
+      globalId(cellId) = isHalo(cellId) ? INVALID_CELLID : offset + localIds[cellId];
+    }
+
+    exchangeHaloData(exchange, [&](const GInt cellId) -> GInt& { return globalId(cellId); });
+    const GInt noUnknownHaloCells = std::count_if(exchange.haloCells.begin(), exchange.haloCells.end(),
+                                                   [&](const GInt cellId) { return globalId(cellId) == INVALID_CELLID; });
+    if(noUnknownHaloCells > 0) {
+      logger << "WARNING: " << noUnknownHaloCells << " halo cells don't exist on their domain" << std::endl;
+    }
+
+    GInt noGlobalCells = 0;
+    MPI_Allreduce(&noLocalCells, &noGlobalCells, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+    logger << SP1 << "Distributed grid has " << noGlobalCells << " cells (" << noLocalCells << " on this domain, "
+           << exchange.haloCells.size() << " halo cells)" << std::endl;
+    cerr0 << SP1 << "Distributed grid has " << noGlobalCells << " cells" << std::endl;
+  }
+
   void save(const GString& fileName, const json& gridOutConfig) const override {
     if(size() == 0) {
       TERMM(-1, "Nothing to save 0 cells in grid!");
@@ -217,8 +960,41 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     GString              type      = config::opt_config_value(gridOutConfig, "type", GString("point"));
     std::vector<GString> outvalues = config::opt_config_value(gridOutConfig, "outputValues", std::vector<GString>({"level"}));
 
-    auto filterList = std::make_unique<CellFilterManager<NDIM>>(config::opt_config_value(gridOutConfig, "cellFilter", json({"leafCells"})));
-
+    // the cells are selected below, i.e., the writers output all passed cells
+    auto filterList = std::make_unique<CellFilterManager<NDIM>>();
+
+    // cells selected by the filter (see CellFilterManager), each domain writes its own cells without the halo cells to a
+    // separate file
+    GInt outputLvl = -1;
+    if(filter == "highestLvl") {
+      outputLvl = currentHighestLvl();
+    } else if(filter == "lowestLvl" || filter == "partitionLvl") {
+      outputLvl = partitionLvl();
+    } else if(filter == "targetLvl") {
+      outputLvl = config::required_config_value<GInt>(gridOutConfig, "outputLvl");
+      if(outputLvl < partitionLvl()) {
+        TERMM(-1, "Outputting a lvl below the partition lvl is not possible!");
+      }
+    } else if(filter != "leafCells") {
+      TERMM(-1, "Unknown output filter " + filter);
+    }
+    std::vector<GInt> outputCells;
+    for(GInt cellId = 0; cellId < size(); ++cellId) {
+      const GBool selected = outputLvl < 0 ? m_noChildren[cellId] == 0 : std::to_integer<GInt>(level(cellId)) == outputLvl;
+      if(selected && !property(cellId, CellProperties::halo)) {
+        outputCells.emplace_back(cellId);
+      }
+    }
+    const auto outputData = [&](const auto& data) {
+      std::vector<typename std::decay_t<decltype(data)>::value_type> selected;
+      selected.reserve(outputCells.size());
+      for(const GInt cellId : outputCells) {
+        selected.emplace_back(data[cellId]);
+      }
+      return selected;
+    };
+    const GInt    noOutputCells  = static_cast<GInt>(outputCells.size());
+    const GString outputFileName = distributed() ? fileName + "_" + std::to_string(MPI::globalDomainId()) : fileName;
 
     std::vector<IOIndex>              index;
     std::vector<std::vector<GString>> values;
@@ -227,26 +1003,45 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
       if(outputvalue == "level") {
         // todo:replace type
         index.emplace_back(IOIndex{"Level", "int64"});
-        values.emplace_back(toStringVector(level(), size()));
+        values.emplace_back(toStringVector(outputData(level())));
         cerr0 << " level ";
       } else if(outputvalue == "noChildren") {
         // todo:replace type
         index.emplace_back(IOIndex{"NoChildren", "int64"});
-        values.emplace_back(toStringVector(m_noChildren, size()));
+        values.emplace_back(toStringVector(outputData(m_noChildren)));
         cerr0 << " noChildren ";
+      } else if(outputvalue == "partitionCell") {
+        std::vector<GInt> partitionCell(size());
+        for(GInt cellId = 0; cellId < size(); ++cellId) {
+          partitionCell[cellId] = static_cast<GInt>(property(cellId, CellProperties::partitionCell));
+        }
+        index.emplace_back(IOIndex{"PartitionCell", "int64"});
+        values.emplace_back(toStringVector(outputData(partitionCell)));
+        cerr0 << " partitionCell ";
+      } else if(outputvalue == "domain") {
+        index.emplace_back(IOIndex{"Domain", "int64"});
+        values.emplace_back(toStringVector(outputData(cellDomains())));
+        cerr0 << " domain ";
       } else {
         logger << "WARNING: The output value " + outputvalue + " is not a valid output!" << std::endl;
       }
     }
     cerr0 << std::endl;
 
+    std::vector<Point<NDIM>> centers(noOutputCells);
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(noOutputCells, outputCells, centers)
+#endif
+    for(GInt id = 0; id < noOutputCells; ++id) {
+      centers[id] = center(outputCells[id]);
+    }
     if(format == "ASCII") {
-      ASCII::writePointsCSV<NDIM>(fileName, size(), center(), filterList.get(), index, values);
+      ASCII::writePointsCSV<NDIM>(outputFileName, noOutputCells, centers, filterList.get(), index, values);
     } else if(format == "VTK") {
-      VTK::ASCII::writePoints<NDIM>(fileName, size(), center(), filterList.get(), index, values);
+      VTK::ASCII::writePoints<NDIM>(outputFileName, noOutputCells, centers, filterList.get(), index, values);
     } else if(format == "VTKB") {
       // todo: rename format
-      VTK::BINARY::writePoints<NDIM>(fileName, size(), center(), filterList.get(), index, values);
+      VTK::BINARY::writePoints<NDIM>(outputFileName, noOutputCells, centers, filterList.get(), index, values);
     } else {
       TERMM(-1, "Unknown output format " + format);
     }
@@ -260,16 +1055,24 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
       actualExtent.max(dir) = std::numeric_limits<GDouble>::min();
     }
 
-    for(GInt cellId = m_levelOffsets[maxLvl()].begin; cellId < m_levelOffsets[maxLvl()].end; ++cellId) {
-      for(GInt dir = 0; dir < NDIM; ++dir) {
-        if(actualExtent.min(dir) > center(cellId, dir)) {
-          actualExtent.min(dir) = center(cellId, dir);
-        }
-        if(actualExtent.max(dir) < center(cellId, dir)) {
-          actualExtent.max(dir) = center(cellId, dir);
+    // a domain might not contain cells on the maximum level
+    const GBool hasMaxLvl = currentHighestLvl() == maxLvl();
+    if(hasMaxLvl) {
+      for(GInt cellId = m_levelOffsets[maxLvl()].begin; cellId < m_levelOffsets[maxLvl()].end; ++cellId) {
+        for(GInt dir = 0; dir < NDIM; ++dir) {
+          if(actualExtent.min(dir) > center(cellId, dir)) {
+            actualExtent.min(dir) = center(cellId, dir);
+          }
+          if(actualExtent.max(dir) < center(cellId, dir)) {
+            actualExtent.max(dir) = center(cellId, dir);
+          }
         }
       }
     }
+    if(distributed()) {
+      MPI_Allreduce(MPI_IN_PLACE, &actualExtent.min(0), NDIM, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+      MPI_Allreduce(MPI_IN_PLACE, &actualExtent.max(0), NDIM, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    }
 
     // check if we are on a square domain
     GBool allExtendIdentical = true;
@@ -286,41 +1089,156 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     GDouble transformationValue = boundingBox().max(alignDir) / (actualExtent.max(alignDir) - actualExtent.min(alignDir));
 
 
-    for(GInt cellId = m_levelOffsets[maxLvl()].begin; cellId < m_levelOffsets[maxLvl()].end; ++cellId) {
-      for(GInt dir = 0; dir < NDIM; ++dir) {
-        // a square domain can be aligned for all directions
-        if(dir == alignDir || allExtendIdentical) {
-          center(cellId, dir) =
-              center(cellId, dir) * transformationValue - (transformationValue * actualExtent.max(dir) - boundingBox().max(dir));
-        } else {
-          center(cellId, dir) = center(cellId, dir) * transformationValue;
-        }
+    // the cell length is scaled by transformMaxLvl() so only the origin of the level is left
+    for(GInt dir = 0; dir < NDIM; ++dir) {
+      // a square domain can be aligned for all directions
+      if(dir == alignDir || allExtendIdentical) {
+        m_lvlOrigin[maxLvl()][dir] =
+            m_lvlOrigin[maxLvl()][dir] * transformationValue - (transformationValue * actualExtent.max(dir) - boundingBox().max(dir));
+      } else {
+        m_lvlOrigin[maxLvl()][dir] = m_lvlOrigin[maxLvl()][dir] * transformationValue;
       }
     }
     transformMaxLvl(transformationValue);
 
     // afterwards there are cells which will be outside
-    deleteOutsideCells<true>(maxLvl());
+    if(hasMaxLvl) {
+      deleteOutsideCells<true>(maxLvl());
+    }
   }
 
   static constexpr auto memorySizePerCell() -> GInt {
-    return sizeof(GInt) * (1 + 1 + 1 + 1 + 2) // m_parentId, m_globalId, m_noChildren, m_rfnDistance, m_levelOffsets
-           + sizeof(Point<NDIM>)              // m_center
-           + sizeof(NeighborList<NDIM>)       // m_nghbrIds
-           + sizeof(ChildList<NDIM>)          // m_childIds
-           + sizeof(PropertyBitsetType)       // m_properties
-           + 1;                               // m_level
+    return sizeof(GInt) * (1 + 1 + 1 + 1 + 2)          // m_parentId, m_globalId, m_noChildren, m_rfnDistance, m_levelOffsets
+           + sizeof(CellCoordinate<NDIM>)              // m_coordinate
+           + NeighborConnectivity::memorySizePerCell() // m_nghbrIds
+           + ChildConnectivity::memorySizePerCell()    // m_childIds
+           + PropertyStorageType::memorySizePerCell()  // m_properties
+           + 1;                                        // m_level
+  }
+
+  [[nodiscard]] auto child(const GInt id, const GInt childId) const -> GInt { return m_childIds(id, childId); }
+
+  /// Number of cells that inherited the classification from their parent instead of checking the geometry.
+  [[nodiscard]] auto noSkippedGeometryChecks() const -> GInt { return m_noSkippedGeometryChecks; }
+
+  /// Integer coordinates of the cell on the uniform grid of its level.
+  [[nodiscard]] auto coordinate(const GInt id) const -> const CellCoordinate<NDIM>& { return m_coordinate[id]; }
+
+  /// Center of the cell, which is derived from the cell coordinates.
+  [[nodiscard]] auto center(const GInt id) const -> Point<NDIM> { return center(m_coordinate[id], std::to_integer<GInt>(level(id))); }
+
+  /// Center of a cell given by its integer coordinates, which remains valid after the cell data has been released.
+  /// \param coordinate Integer coordinates of the cell.
+  /// \param lvl Level of the cell.
+  /// \return Center of the cell.
+  [[nodiscard]] auto center(const CellCoordinate<NDIM>& coordinate, const GInt lvl) const -> Point<NDIM> {
+    const auto& origin = m_lvlOrigin[lvl];
+    Point<NDIM> x;
+    for(GInt dir = 0; dir < NDIM; ++dir) {
+      x[dir] = origin[dir] + (static_cast<GDouble>(coordinate[dir]) + HALF) * lengthOnLvl(lvl);
+    }
+    return x;
   }
 
-  [[nodiscard]] auto child(const GInt id, const GInt childId) const -> GInt { return m_childIds[id].c[childId]; }
+  [[nodiscard]] auto center(const GInt id, const GInt dir) const -> GDouble {
+    const GInt lvl = std::to_integer<GInt>(level(id));
+    return m_lvlOrigin[lvl][dir] + (static_cast<GDouble>(m_coordinate[id][dir]) + HALF) * lengthOnLvl(lvl);
+  }
 
-  [[nodiscard]] auto neighbor(const GInt id, const GInt dir) const -> GInt override { return m_nghbrIds[id].n[dir]; }
+  /// Centers of all cells of the grid.
+  [[nodiscard]] auto cellCenters() const -> std::vector<Point<NDIM>> {
+    std::vector<Point<NDIM>> centers(size());
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(centers)
+#endif
+    for(GInt cellId = 0; cellId < size(); ++cellId) {
+      centers[cellId] = center(cellId);
+    }
+    return centers;
+  }
+
+  [[nodiscard]] auto neighbor(const GInt id, const GInt dir) const -> GInt override { return m_nghbrIds(id, dir); }
+
+  /// Move the neighbor connectivity out of the grid, e.g., to hand the grid over without copying (see
+  /// CartesianGrid::loadGrid()). The grid is invalid afterwards and needs to be released.
+  [[nodiscard]] auto releaseNeighbors() -> NeighborConnectivity { return std::move(m_nghbrIds); }
+
+  /// Move the child connectivity out of the grid (see releaseNeighbors()).
+  [[nodiscard]] auto releaseChildren() -> ChildConnectivity { return std::move(m_childIds); }
+
+  /// Move the integer cell coordinates out of the grid (see releaseNeighbors()).
+  [[nodiscard]] auto releaseCoordinates() -> FirstTouchVector<CellCoordinate<NDIM>> { return std::move(m_coordinate); }
+
+  /// Free the memory of all cell data, e.g., after the grid has been handed over.
+  void releaseMemory() {
+    reset();
+    m_noChildren           = {};
+    m_nghbrIds             = {};
+    m_childIds             = {};
+    m_rfnDistance          = {};
+    m_coordinate           = {};
+    m_refineOffsets        = {};
+    m_regionIds            = {};
+    m_newCellIds           = {};
+    m_partitionCellOffsets = {};
+    m_partitionCells       = {};
+    m_partitionDomains     = {};
+  }
 
  protected:
-  [[nodiscard]] auto neighbor(const GInt id, const GInt dir) -> GInt& { return m_nghbrIds[id].n[dir]; }
+  [[nodiscard]] auto neighbor(const GInt id, const GInt dir) -> IndexType& { return m_nghbrIds(id, dir); }
 
 
  private:
+  void resizeCells(const GInt _capacity) {
+    m_noChildren.resize(_capacity);
+    m_nghbrIds.resize(_capacity);
+    m_childIds.resize(_capacity);
+    m_rfnDistance.resize(_capacity);
+    m_coordinate.resize(_capacity);
+    // the cell centers are derived from the cell coordinates
+    BaseCartesianGrid<DEBUG_LEVEL, NDIM>::setCellCapacity(_capacity);
+  }
+
+  /// Make sure that the capacity is sufficient for the given number of cells. If the capacity is growable it is increased
+  /// by at least a factor of 1.5 (up to the maximum capacity), otherwise the generation is terminated.
+  /// \param requiredCapacity Number of cells that need to be stored.
+  /// \param _level Level that is to be created.
+  void reserveCells(const GInt requiredCapacity, const GInt _level) {
+    if(requiredCapacity <= capacity()) {
+      return;
+    }
+    if(!m_growable || (m_maxCapacity >= 0 && requiredCapacity > m_maxCapacity)) {
+      outOfMemory(_level);
+    }
+
+    GInt newCapacity = std::max(requiredCapacity, capacity() + capacity() / 2);
+    if(m_maxCapacity >= 0) {
+      newCapacity = std::min(newCapacity, m_maxCapacity);
+    }
+    logger << SP2 << "+ growing capacity from " << capacity() << " to " << newCapacity << " cells" << std::endl;
+    resizeCells(newCapacity);
+  }
+
+  /// Make sure that the given level of the partitioning grid and its children fit into the storage. The levels of the
+  /// partitioning grid alternate between both ends of the storage, hence, a level at the end is moved to the very end
+  /// since removing cells or growing the capacity leaves a gap behind it.
+  /// \param _level Level that is to be refined.
+  void preparePartitioningLevel(const GInt _level) {
+    const GInt noCells = levelSize(m_levelOffsets[_level]);
+    reserveCells(noCells * (1 + cartesian::maxNoChildren<NDIM>()), _level + 1);
+
+    const GInt shift = capacity() - m_levelOffsets[_level].end;
+    if(shift == 0 || m_levelOffsets[_level].begin == 0) {
+      return;
+    }
+    // move the cells starting with the last one, since the old and the new range may overlap
+    for(GInt cellId = m_levelOffsets[_level].end - 1; cellId >= m_levelOffsets[_level].begin; --cellId) {
+      copyCell(cellId, cellId + shift);
+    }
+    m_levelOffsets[_level] = {m_levelOffsets[_level].begin + shift, capacity()};
+  }
+
   void outOfMemory(GInt _level) {
     cerr0 << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!" << std::endl;
     logger << "ERROR: Not enough memory to generate grid! Increase maxNoCells: " << capacity() << std::endl;
@@ -336,43 +1254,22 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     TERMM(-1, "Out of memory!");
   }
 
-  /// Refine grid to an one higher level.
-  /// \tparam DISTRIBUTED Grid is using MPI
+  /// Refine grid to an one higher level. The halo cells of a distributed grid are stored within the levels and are
+  /// refined together with the cells of the domain.
   /// \tparam UNIFORM Grid is uniform
   /// \param lvlToBeRefined Level to be refined
-  template <GBool DISTRIBUTED = false, GBool UNIFORM = true>
+  template <GBool UNIFORM = true>
   void refineGrid(const GInt lvlToBeRefined) {
-    if(DISTRIBUTED && !MPI::isSerial()) {
-      // updateHaloOffsets();
-    }
-
+    updateCutElements(lvlToBeRefined);
     if(UNIFORM) {
       refineGrid(m_levelOffsets, lvlToBeRefined);
-      if(DISTRIBUTED && !MPI::isSerial()) {
-        // todo:implement
-        // refineGrid(m_haloOffsets, l);
-      }
     } else {
       refineGridMarkedOnly(m_levelOffsets, lvlToBeRefined);
-      if(DISTRIBUTED && !MPI::isSerial()) {
-        // todo:implement
-        // refineGridMarkedOnly(m_haloOffsets, l);
-      }
     }
     size() = m_levelOffsets[lvlToBeRefined + 1].end;
 
     findChildLevelNghbrs(m_levelOffsets, lvlToBeRefined);
-    if(DISTRIBUTED && !MPI::isSerial()) {
-      // todo:implement
-      // findChildLevelNeighbors(m_haloOffsets, l);
-    }
-
-    if(DISTRIBUTED && !MPI::isSerial()) {
-      // todo:implement
-      //        deleteOutsideCellsParallel(l + 1);
-    } else {
-      deleteOutsideCells(lvlToBeRefined + 1);
-    }
+    deleteOutsideCells(lvlToBeRefined + 1);
 
     size() = m_levelOffsets[lvlToBeRefined + 1].end;
     increaseCurrentHighestLvl();
@@ -407,11 +1304,24 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
   }
 
   void refineGridMarkedOnly(const std::vector<LevelOffsetType>& levelOffset, const GInt _level) {
-    GInt refinedCells = 0;
-    for(GInt cellId = levelOffset[_level].begin; cellId < levelOffset[_level].end; ++cellId) {
+    const GInt firstCellOfLvl = levelOffset[_level].begin;
+    const GInt noCellsOfLvl   = levelSize(levelOffset[_level]);
+    const GInt childOffset    = levelOffset[_level + 1].begin;
+
+    // the position of the children is given by the number of marked cells in front of the cell
+    const GInt refinedCells = algorithm::exclusiveScan(
+        noCellsOfLvl, [&](const GInt id) { return static_cast<GInt>(property(firstCellOfLvl + id, CellProperties::toRefine)); },
+        m_refineOffsets);
+    ASSERT(childOffset + refinedCells * cartesian::maxNoChildren<NDIM>() <= levelOffset[_level + 1].end,
+           "Invalid number of cells to refine!");
+
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstCellOfLvl, noCellsOfLvl, childOffset)
+#endif
+    for(GInt id = 0; id < noCellsOfLvl; ++id) {
+      const GInt cellId = firstCellOfLvl + id;
       if(property(cellId, CellProperties::toRefine)) {
-        refineCell(cellId, levelOffset[_level + 1].begin + refinedCells * cartesian::maxNoChildren<NDIM>());
-        ++refinedCells;
+        refineCell(cellId, childOffset + m_refineOffsets[id] * cartesian::maxNoChildren<NDIM>());
       }
     }
   }
@@ -425,183 +1335,762 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
 
     for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
       const GInt childCellId = offset + childId;
-      center(childCellId) =
-          center(cellId)
-          + HALF * refinedLvlLength
-                * Point<NDIM>(cartesian::childDir[childId].data()); // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+      for(GInt dir = 0; dir < NDIM; ++dir) {
+        m_coordinate[childCellId][dir] =
+            2 * m_coordinate[cellId][dir]
+            + static_cast<GUint32>(cartesian::childDir[childId][dir] > 0); // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+      }
       level(childCellId)    = static_cast<std::byte>(refinedLvl);
       parent(childCellId)   = cellId;
       globalId(childCellId) = childCellId;
 
       // reset since we overwrite previous levels
       m_noChildren[childCellId] = 0;
-      property(childCellId).reset();
-      m_childIds[childCellId] = {INVALID_LIST<cartesian::maxNoChildren<NDIM>()>()};
-      m_nghbrIds[childCellId] = {INVALID_LIST<cartesian::maxNoNghbrs<NDIM>()>()};
+      resetProperties(childCellId);
+      m_childIds.invalidate(childCellId);
+      m_nghbrIds.invalidate(childCellId);
+
+      // children of halo cells belong to the same domain
+      property(childCellId, CellProperties::halo) = property(cellId, CellProperties::halo);
 
       // if parent is a boundary cell check for children as well
       if(property(cellId, CellProperties::bndry)) {
-        property(childCellId, CellProperties::bndry) = cellHasCut(childCellId, refinedLvlLength);
+        const auto [candidates, noCandidates] = cutCandidates(cellId);
+        property(childCellId, CellProperties::bndry) =
+            geometry()->cutWithCell(center(childCellId).data(), refinedLvlLength, candidates, noCandidates);
       }
 
       // update parent
-      m_childIds[cellId].c[childId] = childCellId;
+      m_childIds(cellId, childId) = childCellId;
       m_noChildren[cellId]++;
     }
   }
 
   void findChildLevelNghbrs(const std::vector<LevelOffsetType>& levelOffset, const GInt _level) {
-    // check all children at the given level
+    // check all children at the given level (each parent only writes the neighbors of its own children)
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(levelOffset, _level)
+#endif
     for(GInt parentId = levelOffset[_level].begin; parentId < levelOffset[_level].end; ++parentId) {
-      const GInt* __restrict children = &m_childIds[parentId].c[0];
-      for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
-        if(children[childId] == INVALID_CELLID) {
-          // no child
-          continue;
-        }
+      findChildNghbrs(parentId);
+    }
+  }
 
-        // check all neighbors
-        GInt* __restrict neighbors = &m_nghbrIds[children[childId]].n[0];
-        for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>(); ++dir) {
-          // neighbor direction not set
-          if(neighbors[dir] == INVALID_CELLID) {
-            const GInt nghbrId =
-                static_cast<GInt>(cartesian::nghbrInside[childId][dir]); // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
-            // neighbor is within the same parent cell
-            if(nghbrId != INVALID_CELLID) {
-              neighbors[dir] = children[nghbrId];
-            } else {
-              const GInt parentLvlNeighborChildId = static_cast<GInt>(
-                  cartesian::nghbrParentChildId[childId][dir]); // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
-              ASSERT(parentLvlNeighborChildId > INVALID_CELLID, "The definition of nghbrParentChildId is wrong! "
-                                                                "childId: "
-                                                                    + std::to_string(childId) + " dir " + std::to_string(dir));
-
-              const GInt parentLvlNghbrId = m_nghbrIds[parentId].n[dir];
-              if(parentLvlNghbrId != INVALID_CELLID && parentLvlNeighborChildId != INVALID_CELLID
-                 && m_childIds[parentLvlNghbrId].c[parentLvlNeighborChildId] != INVALID_CELLID) {
-                neighbors[dir] = m_childIds[parentLvlNghbrId].c[parentLvlNeighborChildId];
-              }
+  /// Set the neighbors of the children of a cell from the siblings and the children of the neighbors of the cell.
+  /// \param parentId Cell whose children are updated.
+  void findChildNghbrs(const GInt parentId) {
+    const auto& nghbrInside        = cartesian::nghbrInside;
+    const auto& nghbrParentChildId = cartesian::nghbrParentChildId;
+
+    ChildListType children;
+    for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
+      children[childId] = m_childIds(parentId, childId);
+    }
+    for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
+      if(children[childId] == INVALID_CELLID) {
+        // no child
+        continue;
+      }
+
+      // check all neighbors
+      for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>(); ++dir) {
+        IndexType& nghbr = m_nghbrIds(children[childId], dir);
+        // neighbor direction not set
+        if(nghbr == INVALID_CELLID) {
+          const GInt nghbrId = nghbrInside[childId][dir]; // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+          // neighbor is within the same parent cell
+          if(nghbrId != INVALID_CELLID) {
+            nghbr = children[nghbrId];
+          } else {
+            const GInt parentLvlNeighborChildId = nghbrParentChildId[childId][dir]; // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            ASSERT(parentLvlNeighborChildId > INVALID_CELLID, "The definition of nghbrParentChildId is wrong! "
+                                                              "childId: "
+                                                                  + std::to_string(childId) + " dir " + std::to_string(dir));
+
+            const GInt parentLvlNghbrId = m_nghbrIds(parentId, dir);
+            if(parentLvlNghbrId != INVALID_CELLID && parentLvlNeighborChildId != INVALID_CELLID
+               && m_childIds(parentLvlNghbrId, parentLvlNeighborChildId) != INVALID_CELLID) {
+              nghbr = m_childIds(parentLvlNghbrId, parentLvlNeighborChildId);
             }
+          }
 
-            if(DEBUG_LEVEL >= Debug_Level::debug && neighbors[dir] != INVALID_CELLID
-               && (center(neighbors[dir]) - center(children[childId])).norm()
-                      > 1.9 * lengthOnLvl(std::to_integer<GInt>(level(children[childId])))) {
-              cerr0 << "neighbors[dir] " << neighbors[dir] << " cellId " << children[childId] << std::endl;
-              cerr0 << "neighbors " << strStreamify<NDIM>(center(neighbors[dir])).str() << std::endl;
-              cerr0 << "neighbors " << strStreamify<NDIM>(center(children[childId])).str() << std::endl;
-              cerr0 << "ndiff " << (center(neighbors[dir]) - center(children[childId])).norm() << " vs "
-                    << lengthOnLvl(std::to_integer<GInt>(level(children[childId]))) << std::endl;
-              cerr0 << "parentId " << parentId << " np " << m_nghbrIds[parentId].n[dir] << std::endl;
-              cerr0 << "parent " << strStreamify<NDIM>(center(parentId)).str() << std::endl;
-              cerr0 << "pdiff " << (center(parentId) - center(m_nghbrIds[parentId].n[dir])).norm() << " vs "
-                    << lengthOnLvl(std::to_integer<GInt>(level(parentId))) << std::endl;
-
-              TERMM(-1, "Invalid neighbor");
+          if(DEBUG_LEVEL >= Debug_Level::debug && nghbr != INVALID_CELLID
+             && !isNeighborCoordinate(m_coordinate[children[childId]], m_coordinate[nghbr], dir)) {
+            cerr0 << "nghbr " << nghbr << " cellId " << children[childId] << std::endl;
+            cerr0 << "neighbors " << strStreamify<NDIM>(center(nghbr)).str() << std::endl;
+            cerr0 << "neighbors " << strStreamify<NDIM>(center(children[childId])).str() << std::endl;
+            cerr0 << "ndiff " << (center(nghbr) - center(children[childId])).norm() << " vs "
+                  << lengthOnLvl(std::to_integer<GInt>(level(children[childId]))) << std::endl;
+            cerr0 << "parentId " << parentId << " np " << m_nghbrIds(parentId, dir) << std::endl;
+            cerr0 << "parent " << strStreamify<NDIM>(center(parentId)).str() << std::endl;
+            cerr0 << "pdiff " << (center(parentId) - center(m_nghbrIds(parentId, dir))).norm() << " vs "
+                  << lengthOnLvl(std::to_integer<GInt>(level(parentId))) << std::endl;
+
+            TERMM(-1, "Invalid neighbor");
+          }
+        }
+      }
+    }
+  }
+
+  /// Check if the surface within a boundary cell is not resolved according to the feature-based refinement criterion.
+  /// \param cellId Boundary cell of the level of the cut elements.
+  /// \return The cell needs to be refined.
+  [[nodiscard]] auto surfaceUnresolved(const GInt cellId) const -> GBool {
+    const auto [elements, noElements] = cutCandidates(cellId);
+    const SurfaceFeatures surface     = geometry()->surfaceFeatures(elements, noElements);
+    return surface.normalAngle > m_featureRefinement.normalAngle || surface.dihedralAngle > m_featureRefinement.dihedralAngle
+           || surface.featureSize < m_featureRefinement.cellsPerFeature * lengthOnLvl(currentHighestLvl());
+  }
+
+  /// Report the number of boundary cells that need to be refined according to the feature-based refinement.
+  /// \param featureBased The feature-based refinement is active on the current level.
+  /// \param noUnresolvedCells Number of boundary cells that need to be refined.
+  void logFeatureRefinement(const GBool featureBased, const GInt noUnresolvedCells) const {
+    if(!featureBased) {
+      return;
+    }
+    const GInt noBndryCells =
+        props().count(CellProperties::bndry, m_levelOffsets[currentHighestLvl()].begin, m_levelOffsets[currentHighestLvl()].end);
+    logger << SP3 << "* refining " << noUnresolvedCells << " of " << noBndryCells << " boundary cells to resolve the surface features"
+           << std::endl;
+  }
+
+  /// Mark the cells of the current highest level in the subtree of a cell that intersect one of the regions. Only the
+  /// regions intersecting a cell and the regions that can't prune are passed on to its children.
+  /// \param cellId Root of the subtree.
+  /// \param regions Regions intersecting the parent of the cell.
+  /// \param checkedCells Number of checked cells.
+  /// \return Number of additionally marked cells.
+  auto markRegionSubtree(const GInt cellId, const std::vector<const RefinementRegion<NDIM>*>& regions, GInt& checkedCells) -> GInt {
+    const GInt        lvl        = std::to_integer<GInt>(level(cellId));
+    const GDouble     cellLength = lengthOnLvl(lvl);
+    const Point<NDIM> x          = center(cellId);
+    ++checkedCells;
+
+    std::vector<const RefinementRegion<NDIM>*> cutRegions;
+    for(const auto* region : regions) {
+      if((lvl < currentHighestLvl() && !region->canPrune()) || region->cutWithCell(x, cellLength)) {
+        cutRegions.emplace_back(region);
+      }
+    }
+    if(cutRegions.empty()) {
+      return 0;
+    }
+
+    if(lvl == currentHighestLvl()) {
+      const GBool newlyMarked                    = !property(cellId, CellProperties::toRefine);
+      property(cellId, CellProperties::toRefine) = true;
+      return static_cast<GInt>(newlyMarked);
+    }
+    GInt markedCells = 0;
+    for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
+      const GInt childCellId = m_childIds(cellId, childId);
+      if(childCellId != INVALID_CELLID) {
+        markedCells += markRegionSubtree(childCellId, cutRegions, checkedCells);
+      }
+    }
+    return markedCells;
+  }
+
+  /// Refine leaf cells of levels below the current highest level. The children are appended level by level and the cells
+  /// are rearranged afterwards such that the children follow the cells of their level. The leaf cells need all neighbors
+  /// of their level. The children of boundary leaf cells (e.g. resolved by the feature refinement) are checked for a cut
+  /// and whether they are inside, the outside children are removed during the rearrangement.
+  /// \param leafCells Leaf cells to be refined ordered by their level.
+  void refineLeafCells(const std::vector<GInt>& leafCells) {
+    static constexpr GInt noChildren = cartesian::maxNoChildren<NDIM>();
+    const GInt            noCells    = size();
+    const GInt            noNewCells = static_cast<GInt>(leafCells.size()) * noChildren;
+    ASSERT(m_levelOffsets[partitionLvl()].begin == 0, "Partitioning grid is not at the beginning!");
+    ASSERT(m_levelOffsets[currentHighestLvl()].end == noCells, "Invalid level offsets!");
+    reserveCells(noCells + noNewCells, currentHighestLvl());
+    size() = noCells + noNewCells;
+
+    // the leaf cells of each level are refined after the lower levels, which completes the neighbors of their level
+    std::vector<GInt> noNewCellsOfLvl(currentHighestLvl() + 2, 0);
+    GInt              firstLeafCell = 0;
+    for(GInt lvl = partitionLvl(); lvl < currentHighestLvl(); ++lvl) {
+      const auto lastLeaf      = std::lower_bound(leafCells.begin(), leafCells.end(), m_levelOffsets[lvl].end);
+      const GInt lastLeafCell  = static_cast<GInt>(lastLeaf - leafCells.begin());
+      noNewCellsOfLvl[lvl + 1] = (lastLeafCell - firstLeafCell) * noChildren;
+#ifdef _OPENMP
+#pragma omp parallel default(none) shared(leafCells, firstLeafCell, lastLeafCell, noCells)
+      {
+#pragma omp for
+#endif
+        for(GInt id = firstLeafCell; id < lastLeafCell; ++id) {
+          ASSERT(m_noChildren[leafCells[id]] == 0, "Invalid leaf cell!");
+          refineCell(leafCells[id], noCells + id * noChildren);
+          const GBool bndryLeaf = property(leafCells[id], CellProperties::bndry);
+          for(GInt childCellId = noCells + id * noChildren; childCellId < noCells + (id + 1) * noChildren; ++childCellId) {
+            // the cut of the children of boundary cells is already checked by refineCell()
+            const GBool inside = !bndryLeaf || property(childCellId, CellProperties::bndry) || pointIsInside(center(childCellId));
+            property(childCellId, CellProperties::inside) = inside;
+            m_noChildren[leafCells[id]] -= static_cast<GInt>(!inside);
+          }
+        }
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for(GInt id = firstLeafCell; id < lastLeafCell; ++id) {
+          findChildNghbrs(leafCells[id]);
+          // each face of an existing cell is adjacent to at most one of the new cells
+          for(GInt cellId = noCells + id * noChildren; cellId < noCells + (id + 1) * noChildren; ++cellId) {
+            for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>(); ++dir) {
+              const GInt nghbrId = m_nghbrIds(cellId, dir);
+              if(nghbrId != INVALID_CELLID && nghbrId < noCells) {
+                m_nghbrIds(nghbrId, cartesian::oppositeDir(dir)) = cellId;
+              }
             }
           }
         }
+#ifdef _OPENMP
       }
+#endif
+      firstLeafCell = lastLeafCell;
     }
+
+    // the children are moved behind the cells of their level and the outside children are removed
+    m_newCellIds.resize(noCells + noNewCells);
+    GInt newOffset   = 0;
+    GInt childOffset = noCells;
+    for(GInt lvl = partitionLvl(); lvl <= currentHighestLvl(); ++lvl) {
+      const GInt firstCellOfLvl = m_levelOffsets[lvl].begin;
+      const GInt noCellsOfLvl   = levelSize(m_levelOffsets[lvl]);
+      ASSERT(lvl == partitionLvl() || firstCellOfLvl == m_levelOffsets[lvl - 1].end, "Levels are not contiguous!");
+      std::iota(m_newCellIds.begin() + firstCellOfLvl, m_newCellIds.begin() + firstCellOfLvl + noCellsOfLvl, newOffset);
+      const GInt noKeptChildren = algorithm::exclusiveScan(
+          noNewCellsOfLvl[lvl], [&](const GInt id) { return static_cast<GInt>(property(childOffset + id, CellProperties::inside)); },
+          m_newCellIds.data() + childOffset);
+      for(GInt cellId = childOffset; cellId < childOffset + noNewCellsOfLvl[lvl]; ++cellId) {
+        m_newCellIds[cellId] = property(cellId, CellProperties::inside) ? newOffset + noCellsOfLvl + m_newCellIds[cellId] : INVALID_CELLID;
+      }
+      m_levelOffsets[lvl] = {newOffset, newOffset + noCellsOfLvl + noKeptChildren};
+      newOffset += noCellsOfLvl + noKeptChildren;
+      childOffset += noNewCellsOfLvl[lvl];
+    }
+    reorderCells(0, noCells + noNewCells, newOffset);
+    size() = newOffset;
+  }
+
+  /// Determine the geometry elements cutting the boundary cells of a level, which are the candidates for the cut check of
+  /// their children. Only the elements cutting the parent can cut a cell, hence, the geometry is only searched completely
+  /// for cells without candidates of their parent. The elements of the parent level are dropped afterwards.
+  /// \param _level Level to be refined.
+  void updateCutElements(const GInt _level) {
+    const GInt firstCellOfLvl = m_levelOffsets[_level].begin;
+    const GInt noCellsOfLvl   = levelSize(m_levelOffsets[_level]);
+    // already determined for the marking of the cells
+    if(m_cutElements.level == _level && static_cast<GInt>(m_cutElements.offsets.size()) == noCellsOfLvl + 1) {
+      return;
+    }
+    const GDouble cellLength = lengthOnLvl(_level);
+#ifdef _OPENMP
+    const GInt noThreads = omp_get_max_threads();
+#else
+    const GInt noThreads = 1;
+#endif
+
+    CutElements cutElements;
+    cutElements.level = _level;
+    cutElements.offsets.assign(noCellsOfLvl + 1, 0);
+    std::vector<std::vector<GInt>> threadElements(noThreads);
+#ifdef _OPENMP
+#pragma omp parallel default(none) shared(firstCellOfLvl, noCellsOfLvl, cellLength, cutElements, threadElements)
+#endif
+    {
+#ifdef _OPENMP
+      std::vector<GInt>& elements = threadElements[omp_get_thread_num()];
+#pragma omp for schedule(static)
+#else
+      std::vector<GInt>& elements = threadElements[0];
+#endif
+      for(GInt id = 0; id < noCellsOfLvl; ++id) {
+        const GInt cellId = firstCellOfLvl + id;
+        if(property(cellId, CellProperties::bndry)) {
+          const auto [candidates, noCandidates] = cutCandidates(parent(cellId));
+          const GInt noElements                 = static_cast<GInt>(elements.size());
+          geometry()->cutElements(center(cellId), cellLength, candidates, noCandidates, elements, false);
+          cutElements.offsets[id + 1] = static_cast<GInt>(elements.size()) - noElements;
+        }
+      }
+    }
+
+    // the static schedule assigns consecutive cells to the threads in their order
+    std::partial_sum(cutElements.offsets.begin(), cutElements.offsets.end(), cutElements.offsets.begin());
+    // the storage is never empty, since cells without elements still need valid (empty) candidates
+    cutElements.elements.reserve(std::max(cutElements.offsets.back(), GInt(1)));
+    for(const auto& elements : threadElements) {
+      cutElements.elements.insert(cutElements.elements.end(), elements.begin(), elements.end());
+    }
+    m_cutElements = std::move(cutElements);
+  }
+
+  /// Geometry elements cutting a cell if they have been determined for its level.
+  /// \param cellId Cell to be checked.
+  /// \return Pointer to the elements and their number or nullptr if no elements are available.
+  [[nodiscard]] auto cutCandidates(const GInt cellId) const -> std::pair<const GInt*, GInt> {
+    if(cellId == INVALID_CELLID || std::to_integer<GInt>(level(cellId)) != m_cutElements.level) {
+      return {nullptr, 0};
+    }
+    const GInt id = cellId - m_levelOffsets[m_cutElements.level].begin;
+    ASSERT(id >= 0 && id + 1 < static_cast<GInt>(m_cutElements.offsets.size()), "Invalid cell of the cut elements!");
+    return {m_cutElements.elements.data() + m_cutElements.offsets[id], m_cutElements.offsets[id + 1] - m_cutElements.offsets[id]};
   }
 
   template <GBool CHECKALL = false>
   void deleteOutsideCells(const GInt _level) {
     markOutsideCells<CHECKALL>(m_levelOffsets, _level);
+    if(distributed()) {
+      markDistantHaloCells(_level);
+    }
 
     // delete cells that have been marked as being outside
-    for(GInt cellId = m_levelOffsets[_level].end - 1; cellId >= m_levelOffsets[_level].begin; --cellId) {
-      ASSERT(!property(cellId, CellProperties::bndry)
-                 || property(cellId, CellProperties::inside) == property(cellId, CellProperties::bndry),
-             "Properties not set correctly! bndry implies IsInside!");
-      // remove cell since it is not inside
-      if(!property(cellId, CellProperties::inside)) {
-        deleteCell(cellId);
-      }
-    }
+    compactLevel(_level);
     size() = levelSize(m_levelOffsets[_level]);
     logger << SP3 << "* grid has " << size() << " cells" << std::endl;
     std::cout << SP3 << "* grid has " << size() << " cells" << std::endl;
   }
 
-  void deleteCell(const GInt cellId) {
-    const GInt parentId = parent(cellId);
-    const GInt lvl      = static_cast<GInt>(level(cellId));
+  /// Remove all cells of a level that are not marked as inside in bulk. The remaining cells are moved to the beginning of
+  /// the level while keeping their order and all parent, child and neighbor references to them are updated.
+  /// \param _level Level to be compacted.
+  void compactLevel(const GInt _level) {
+    const GInt firstCellOfLvl = m_levelOffsets[_level].begin;
+    const GInt noCellsOfLvl   = levelSize(m_levelOffsets[_level]);
+
+    // new position of each remaining cell relative to the beginning of the level
+    const GInt noKeptCells = algorithm::exclusiveScan(
+        noCellsOfLvl,
+        [&](const GInt id) {
+          const GInt cellId = firstCellOfLvl + id;
+          ASSERT(!property(cellId, CellProperties::bndry)
+                     || property(cellId, CellProperties::inside) == property(cellId, CellProperties::bndry),
+                 "Properties not set correctly! bndry implies IsInside!");
+          return static_cast<GInt>(property(cellId, CellProperties::inside));
+        },
+        m_newCellIds);
+    if(noKeptCells == noCellsOfLvl) {
+      return;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstCellOfLvl, noCellsOfLvl)
+#endif
+    for(GInt id = 0; id < noCellsOfLvl; ++id) {
+      const GInt cellId = firstCellOfLvl + id;
+      ASSERT(property(cellId, CellProperties::inside) || m_noChildren[cellId] == 0, "Removing a cell with children!");
+      m_newCellIds[id] = property(cellId, CellProperties::inside) ? firstCellOfLvl + m_newCellIds[id] : INVALID_CELLID;
+    }
+
+    reorderCells(firstCellOfLvl, noCellsOfLvl, noKeptCells);
+
+    const auto newCellId = [&](const GInt cellId) {
+      return cellId >= firstCellOfLvl && cellId < firstCellOfLvl + noCellsOfLvl ? m_newCellIds[cellId - firstCellOfLvl] : cellId;
+    };
 
     // partitionlvl doesn't have parents
-    if(lvl != partitionLvl()) {
-      ASSERT(parentId != INVALID_CELLID, "Invalid parentId! (cellId: " + std::to_string(cellId) + ")");
+    if(_level != partitionLvl()) {
+      const GInt firstParentId = m_levelOffsets[_level - 1].begin;
+      const GInt lastParentId  = m_levelOffsets[_level - 1].end;
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstParentId, lastParentId, newCellId)
+#endif
+      for(GInt parentId = firstParentId; parentId < lastParentId; ++parentId) {
+        GInt noChildren = 0;
+        for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
+          IndexType& childCellId = m_childIds(parentId, childId);
+          if(childCellId != INVALID_CELLID) {
+            childCellId = newCellId(childCellId);
+            noChildren += static_cast<GInt>(childCellId != INVALID_CELLID);
+          }
+        }
+        m_noChildren[parentId] = noChildren;
+      }
+    }
 
-      // remove from parent
-      updateParent(parent(cellId), cellId, INVALID_CELLID);
-      --m_noChildren[parentId];
+    m_levelOffsets[_level].end = firstCellOfLvl + noKeptCells;
+  }
+
+  /// Move the cells [firstCell, firstCell + noCells) to the positions given by m_newCellIds (INVALID_CELLID for cells to
+  /// be removed). The new positions need to be a permutation of [firstCell, firstCell + noNewCells). Each cell data array
+  /// is gathered once into a scratch buffer and afterwards the connectivity of the moved cells is remapped. Children
+  /// outside of the range are updated, references from parents outside of the range need to be updated by the caller.
+  /// \param firstCell First cell of the range.
+  /// \param noCells Number of cells in the range.
+  /// \param noNewCells Number of cells in the range after reordering.
+  void reorderCells(const GInt firstCell, const GInt noCells, const GInt noNewCells) {
+    ASSERT(static_cast<GInt>(m_newCellIds.size()) == noCells, "Invalid size of the new cell ids!");
+
+    gatherCells(
+        firstCell, noCells, noNewCells, [&](const GInt cellId) { return properties(cellId); },
+        [&](const GInt cellId, const PropertyBitsetType& bits) { assignProperties(cellId, bits); });
+    gatherCells(firstCell, noCells, noNewCells, [&](const GInt cellId) -> auto& { return level(cellId); });
+    gatherCells(firstCell, noCells, noNewCells, [&](const GInt cellId) -> auto& { return m_coordinate[cellId]; });
+    gatherCells(firstCell, noCells, noNewCells, [&](const GInt cellId) -> auto& { return globalId(cellId); });
+    gatherCells(firstCell, noCells, noNewCells, [&](const GInt cellId) -> auto& { return parent(cellId); });
+    for(GInt arrayId = 0; arrayId < NeighborConnectivity::noArrays(); ++arrayId) {
+      gatherCells(firstCell, noCells, noNewCells, [&](const GInt cellId) -> auto& { return m_nghbrIds.element(arrayId, cellId); });
     }
+    for(GInt arrayId = 0; arrayId < ChildConnectivity::noArrays(); ++arrayId) {
+      gatherCells(firstCell, noCells, noNewCells, [&](const GInt cellId) -> auto& { return m_childIds.element(arrayId, cellId); });
+    }
+    gatherCells(firstCell, noCells, noNewCells, [&](const GInt cellId) -> auto& { return m_noChildren[cellId]; });
+    gatherCells(firstCell, noCells, noNewCells, [&](const GInt cellId) -> auto& { return m_rfnDistance[cellId]; });
 
-    // remove from neighbors
-    for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>(); ++dir) {
-      const GInt nghbrCellId = m_nghbrIds[cellId].n[dir];
-      if(nghbrCellId != INVALID_CELLID) {
-        m_nghbrIds[nghbrCellId].n[cartesian::oppositeDir(dir)] = INVALID_CELLID;
+    const auto inRange = [&](const GInt cellId) { return cellId >= firstCell && cellId < firstCell + noCells; };
+
+    // update the references of the moved cells and their children
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstCell, noNewCells, inRange)
+#endif
+    for(GInt cellId = firstCell; cellId < firstCell + noNewCells; ++cellId) {
+      for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>(); ++dir) {
+        IndexType& nghbrId = m_nghbrIds(cellId, dir);
+        if(nghbrId != INVALID_CELLID) {
+          ASSERT(inRange(nghbrId), "Neighbor outside of the reordered range!");
+          nghbrId = m_newCellIds[nghbrId - firstCell];
+        }
+      }
+      for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
+        IndexType& childCellId = m_childIds(cellId, childId);
+        if(childCellId == INVALID_CELLID) {
+          continue;
+        }
+        if(inRange(childCellId)) {
+          childCellId = m_newCellIds[childCellId - firstCell];
+        } else {
+          parent(childCellId) = cellId;
+        }
+      }
+      if(parent(cellId) != INVALID_CELLID && inRange(parent(cellId))) {
+        parent(cellId) = m_newCellIds[parent(cellId) - firstCell];
       }
     }
-    if(cellId != m_levelOffsets[lvl].end - 1) {
-      // copy an inside cell to the current position to fill the hole
-      copyCell(m_levelOffsets[lvl].end - 1, cellId);
+  }
+
+  /// Move the data of the cells [firstCell, firstCell + noCells) to the positions given by m_newCellIds.
+  /// \tparam Accessor Callable returning a reference to the cell data.
+  /// \param firstCell First cell of the range.
+  /// \param noCells Number of cells in the range.
+  /// \param noNewCells Number of cells in the range after reordering.
+  /// \param data Accessor of the cell data.
+  template <class Accessor>
+  void gatherCells(const GInt firstCell, const GInt noCells, const GInt noNewCells, Accessor&& data) {
+    gatherCells(firstCell, noCells, noNewCells, data, [&](const GInt cellId, const auto& value) { data(cellId) = value; });
+  }
+
+  /// Move the data of the cells [firstCell, firstCell + noCells) to the positions given by m_newCellIds for data that
+  /// is not addressable per cell (e.g. the cell properties).
+  /// \tparam Getter Callable returning the cell data by value.
+  /// \tparam Setter Callable assigning the cell data.
+  /// \param firstCell First cell of the range.
+  /// \param noCells Number of cells in the range.
+  /// \param noNewCells Number of cells in the range after reordering.
+  /// \param get Getter of the cell data.
+  /// \param set Setter of the cell data.
+  template <class Getter, class Setter>
+  void gatherCells(const GInt firstCell, const GInt noCells, const GInt noNewCells, Getter&& get, Setter&& set) {
+    using DataType = std::decay_t<decltype(get(firstCell))>;
+    std::vector<DataType> buffer(noNewCells);
+#ifdef _OPENMP
+#pragma omp parallel default(none) shared(firstCell, noCells, noNewCells, get, set, buffer)
+    {
+#pragma omp for
+#endif
+      for(GInt id = 0; id < noCells; ++id) {
+        if(m_newCellIds[id] != INVALID_CELLID) {
+          buffer[m_newCellIds[id] - firstCell] = get(firstCell + id);
+        }
+      }
+#ifdef _OPENMP
+#pragma omp for
+#endif
+      for(GInt id = 0; id < noNewCells; ++id) {
+        set(firstCell + id, buffer[id]);
+      }
+#ifdef _OPENMP
     }
-    m_levelOffsets[lvl].end--;
+#endif
   }
 
   template <GBool CHECKALL = false>
   void markOutsideCells(const std::vector<LevelOffsetType>& levelOffset, const GInt _level) {
     if(CHECKALL) {
+      // a cell inside of a parent that is completely inside without a cut is inside as well, i.e., the geometry only needs
+      // to be checked if the cell is not contained in such a parent (e.g., the cells have been moved)
+      const auto inheritsInside = [&](const GInt cellId) {
+        const GInt parentId = parent(cellId);
+        if(parentId == INVALID_CELLID || property(parentId, CellProperties::bndry) || !property(parentId, CellProperties::inside)) {
+          return false;
+        }
+        const GDouble halfLength       = HALF * lengthOnLvl(std::to_integer<GInt>(level(cellId)));
+        const GDouble parentHalfLength = HALF * lengthOnLvl(std::to_integer<GInt>(level(parentId)));
+        for(GInt dir = 0; dir < NDIM; ++dir) {
+          if(std::abs(center(cellId, dir) - center(parentId, dir)) + halfLength > parentHalfLength) {
+            return false;
+          }
+        }
+        return true;
+      };
+
+      GInt noSkipped = 0;
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(levelOffset, _level, inheritsInside) reduction(+ : noSkipped) schedule(dynamic, 64)
+#endif
       for(GInt cellId = levelOffset[_level].begin; cellId < levelOffset[_level].end; ++cellId) {
+        if(inheritsInside(cellId)) {
+          property(cellId, CellProperties::bndry)  = false;
+          property(cellId, CellProperties::inside) = true;
+          ++noSkipped;
+          continue;
+        }
         const GBool isBndryCell                  = cellHasCut(cellId);
         property(cellId, CellProperties::bndry)  = isBndryCell;
         property(cellId, CellProperties::inside) = isBndryCell || pointIsInside(center(cellId));
       }
+      m_noSkippedGeometryChecks += noSkipped;
+      logger << SP3 << "* skipped the geometry checks of " << noSkipped << " of " << levelSize(levelOffset[_level])
+             << " cells with a parent completely inside" << std::endl;
     } else {
-      // reset marked property
-      for(GInt cellId = levelOffset[_level].begin; cellId < levelOffset[_level].end; ++cellId) {
-        property(cellId, CellProperties::marked) = false;
+      // label the connected regions of non-boundary cells, which are either completely inside or outside
+      const GInt firstCellOfLvl = levelOffset[_level].begin;
+      const GInt noCellsOfLvl   = levelSize(levelOffset[_level]);
+      const GInt noRegions      = algorithm::connectedComponents(
+          noCellsOfLvl, cartesian::maxNoNghbrs<NDIM>(),
+          [&](const GInt id) { return !property(firstCellOfLvl + id, CellProperties::bndry); },
+          [&](const GInt id, const GInt dir) {
+            const GInt nghbrId = m_nghbrIds(firstCellOfLvl + id, dir);
+            return nghbrId == INVALID_CELLID ? INVALID_CELLID : nghbrId - firstCellOfLvl;
+          },
+          m_regionIds);
+      logger << SP3 << "* found " << noRegions << " regions of non-boundary cells" << std::endl;
+
+      // a single inside check for the first cell of each region
+      props().fill(CellProperties::marked, firstCellOfLvl, firstCellOfLvl + noCellsOfLvl, true);
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstCellOfLvl, noCellsOfLvl) schedule(dynamic, 64)
+#endif
+      for(GInt id = 0; id < noCellsOfLvl; ++id) {
+        const GInt cellId = firstCellOfLvl + id;
+        if(m_regionIds[id] == id) {
+          property(cellId, CellProperties::inside) = pointIsInside(center(cellId));
+        }
       }
 
-      for(GInt cellId = levelOffset[_level].begin; cellId < levelOffset[_level].end; ++cellId) {
-        if(property(cellId, CellProperties::marked)) {
-          continue;
+      // broadcast the result to all cells of the region
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstCellOfLvl, noCellsOfLvl)
+#endif
+      for(GInt id = 0; id < noCellsOfLvl; ++id) {
+        const GInt cellId = firstCellOfLvl + id;
+        if(m_regionIds[id] == INVALID_CELLID) {
+          // boundary cells are always inside
+          property(cellId, CellProperties::inside) = true;
+        } else if(m_regionIds[id] != id) {
+          property(cellId, CellProperties::inside) = property(firstCellOfLvl + m_regionIds[id], CellProperties::inside);
         }
-        property(cellId, CellProperties::marked) = true;
-        const GBool isBndryCell                  = property(cellId, CellProperties::bndry);
-        property(cellId, CellProperties::inside) = isBndryCell || pointIsInside(center(cellId));
-        if(!isBndryCell) {
-          floodCells(cellId);
+      }
+    }
+  }
+
+  /// Geometry elements cutting the boundary cells of a level in compressed row format.
+  struct CutElements {
+    GInt level = -1;
+    // first element of each cell relative to the beginning of the level
+    std::vector<GInt> offsets{};
+    std::vector<GInt> elements{};
+  };
+
+  /// Communication pattern between the halo cells and the corresponding cells of the domains owning them.
+  struct HaloExchange {
+    // number of halo cells of each owning domain and their offsets
+    std::vector<int> haloCount{};
+    std::vector<int> haloOffsets{};
+    // number of cells requested by each domain and their offsets
+    std::vector<int> windowCount{};
+    std::vector<int> windowOffsets{};
+    // halo cells ordered by the owning domain
+    std::vector<GInt> haloCells{};
+    // cells requested by the other domains (INVALID_CELLID if the cell doesn't exist on this domain)
+    std::vector<GInt> windowCells{};
+  };
+
+  /// Determine the communication pattern for the halo cells in the range [firstCell, lastCell). The domain owning a halo
+  /// cell is given by the global id of its partitioning cell and the cell is identified by its level and coordinates.
+  /// Only the cells of the range adjacent to a halo cell can be requested.
+  /// \param firstCell First cell of the range.
+  /// \param lastCell End of the range.
+  /// \return The communication pattern.
+  auto setupHaloExchange(const GInt firstCell, const GInt lastCell) const -> HaloExchange {
+    using KeyType        = std::array<GUint32, NDIM + 1>;
+    const GInt noDomains = MPI::globalNoDomains();
+    const auto isHalo    = [&](const GInt cellId) { return property(cellId, CellProperties::halo); };
+    const auto cellKey   = [&](const GInt cellId) {
+      KeyType key{};
+      key[0] = static_cast<GUint32>(std::to_integer<GInt>(level(cellId)));
+      std::copy(m_coordinate[cellId].begin(), m_coordinate[cellId].end(), key.begin() + 1);
+      return key;
+    };
+
+    HaloExchange      exchange;
+    std::vector<GInt> haloCells;
+    std::vector<int>  haloDomain;
+    exchange.haloCount.assign(noDomains, 0);
+    for(GInt cellId = firstCell; cellId < lastCell; ++cellId) {
+      if(isHalo(cellId)) {
+        GInt partitionCellId = cellId;
+        while(std::to_integer<GInt>(level(partitionCellId)) > partitionLvl()) {
+          partitionCellId = parent(partitionCellId);
         }
+        const GInt partitionId = globalId(partitionCellId);
+        const auto domainId =
+            static_cast<int>(std::upper_bound(m_domainOffsets.begin(), m_domainOffsets.end(), partitionId) - m_domainOffsets.begin() - 1);
+        ASSERT(domainId != MPI::globalDomainId(), "Invalid domain of the halo cell!");
+        haloCells.emplace_back(cellId);
+        haloDomain.emplace_back(domainId);
+        ++exchange.haloCount[domainId];
+      }
+    }
+
+    exchange.windowCount.assign(noDomains, 0);
+    MPI_Alltoall(exchange.haloCount.data(), 1, MPI_INT, exchange.windowCount.data(), 1, MPI_INT, MPI_COMM_WORLD);
+    exchange.haloOffsets.assign(noDomains + 1, 0);
+    exchange.windowOffsets.assign(noDomains + 1, 0);
+    std::partial_sum(exchange.haloCount.begin(), exchange.haloCount.end(), exchange.haloOffsets.begin() + 1);
+    std::partial_sum(exchange.windowCount.begin(), exchange.windowCount.end(), exchange.windowOffsets.begin() + 1);
+
+    // request the halo cells by their level and coordinates
+    std::vector<KeyType> requests(exchange.haloOffsets.back());
+    std::vector<int>     position(exchange.haloOffsets.begin(), exchange.haloOffsets.end() - 1);
+    exchange.haloCells.resize(exchange.haloOffsets.back());
+    for(GUint id = 0; id < haloCells.size(); ++id) {
+      const int pos           = position[haloDomain[id]]++;
+      requests[pos]           = cellKey(haloCells[id]);
+      exchange.haloCells[pos] = haloCells[id];
+    }
+    std::vector<KeyType> receivedRequests(exchange.windowOffsets.back());
+    const auto           scaled = [](std::vector<int> counts) {
+      for(auto& count : counts) {
+        count *= NDIM + 1;
       }
+      return counts;
+    };
+    MPI_Alltoallv(requests.data(), scaled(exchange.haloCount).data(), scaled(exchange.haloOffsets).data(), MPI_UINT32_T,
+                  receivedRequests.data(), scaled(exchange.windowCount).data(), scaled(exchange.windowOffsets).data(), MPI_UINT32_T,
+                  MPI_COMM_WORLD);
+
+    std::vector<std::pair<KeyType, GInt>> windowCells;
+    for(GInt cellId = firstCell; cellId < lastCell; ++cellId) {
+      GBool window = false;
+      for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>() && !window && !isHalo(cellId); ++dir) {
+        window = adjacentTo(cellId, dir, isHalo);
+      }
+      if(window) {
+        windowCells.emplace_back(cellKey(cellId), cellId);
+      }
+    }
+    std::sort(windowCells.begin(), windowCells.end());
+    exchange.windowCells.resize(exchange.windowOffsets.back());
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(receivedRequests, windowCells, exchange)
+#endif
+    for(GUint id = 0; id < receivedRequests.size(); ++id) {
+      const auto it = std::lower_bound(windowCells.begin(), windowCells.end(), receivedRequests[id],
+                                       [](const auto& windowCell, const KeyType& key) { return windowCell.first < key; });
+      exchange.windowCells[id] = it != windowCells.end() && it->first == receivedRequests[id] ? it->second : INVALID_CELLID;
     }
+    return exchange;
   }
 
-  void floodCells(GInt cellId) {
-    std::stack<GInt> flooding;
-    flooding.template emplace(cellId);
-    const GBool inside = property(cellId, CellProperties::inside);
+  /// Send the data of the requested cells to the halo cells of the other domains. Halo cells which don't exist on the
+  /// domain owning them receive INVALID_CELLID.
+  /// \tparam Accessor Callable returning a reference to the (GInt) cell data.
+  /// \param exchange Communication pattern.
+  /// \param data Accessor of the cell data.
+  template <class Accessor>
+  void exchangeHaloData(const HaloExchange& exchange, Accessor&& data) {
+    std::vector<GInt> sendData(exchange.windowCells.size());
+    for(GUint id = 0; id < exchange.windowCells.size(); ++id) {
+      sendData[id] = exchange.windowCells[id] == INVALID_CELLID ? INVALID_CELLID : data(exchange.windowCells[id]);
+    }
+    std::vector<GInt> recvData(exchange.haloCells.size());
+    MPI_Alltoallv(sendData.data(), exchange.windowCount.data(), exchange.windowOffsets.data(), MPI_INT64_T, recvData.data(),
+                  exchange.haloCount.data(), exchange.haloOffsets.data(), MPI_INT64_T, MPI_COMM_WORLD);
+    for(GUint id = 0; id < exchange.haloCells.size(); ++id) {
+      data(exchange.haloCells[id]) = recvData[id];
+    }
+  }
 
-    while(!flooding.empty()) {
-      const GInt currentCellId = flooding.top();
-      flooding.pop();
-      for(GInt id = 0; id < cartesian::maxNoNghbrs<NDIM>(); ++id) {
-        const GInt nghbrId = m_nghbrIds[currentCellId].n[id];
-        if(nghbrId != INVALID_CELLID && !property(nghbrId, CellProperties::marked)) {
-          property(nghbrId, CellProperties::marked) = true;
-          if(!property(nghbrId, CellProperties::bndry)) {
-            property(nghbrId, CellProperties::inside) = inside;
-            flooding.template emplace(nghbrId);
-          } else {
-            property(nghbrId, CellProperties::inside) = true;
-          }
+  /// Mark the halo cells of a level which are not adjacent to a remaining cell of this domain as being outside, such
+  /// that only a single layer of halo cells is kept. The children of removed halo cells would not be adjacent either.
+  /// \param _level Level of which the halo cells are checked.
+  void markDistantHaloCells(const GInt _level) {
+    const GInt firstCellOfLvl = m_levelOffsets[_level].begin;
+    const GInt lastCellOfLvl  = m_levelOffsets[_level].end;
+    const auto isLocal        = [&](const GInt cellId) {
+      return !property(cellId, CellProperties::halo) && property(cellId, CellProperties::inside);
+    };
+
+    // the properties of the neighbors are read, hence, the halo cells are marked afterwards
+    std::vector<GUchar> distant(lastCellOfLvl - firstCellOfLvl, 0);
+#ifdef _OPENMP
+#pragma omp parallel default(none) shared(firstCellOfLvl, lastCellOfLvl, isLocal, distant)
+    {
+#pragma omp for
+#endif
+      for(GInt cellId = firstCellOfLvl; cellId < lastCellOfLvl; ++cellId) {
+        if(!property(cellId, CellProperties::halo) || !property(cellId, CellProperties::inside)) {
+          continue;
+        }
+        GBool adjacent = false;
+        for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>() && !adjacent; ++dir) {
+          adjacent = adjacentTo(cellId, dir, isLocal);
+        }
+        distant[cellId - firstCellOfLvl] = static_cast<GUchar>(!adjacent);
+      }
+#ifdef _OPENMP
+#pragma omp for
+#endif
+      for(GInt cellId = firstCellOfLvl; cellId < lastCellOfLvl; ++cellId) {
+        if(distant[cellId - firstCellOfLvl] != 0) {
+          property(cellId, CellProperties::inside) = false;
+          property(cellId, CellProperties::bndry)  = false;
         }
       }
+#ifdef _OPENMP
     }
+#endif
   }
 
+  /// Check if the cell is adjacent to a cell fulfilling the condition in the given direction. If the cell has no neighbor
+  /// in this direction, the neighbor of the parent is checked as long as the cell is located at the corresponding face
+  /// of its parent, i.e., the adjacent cell might be on a lower level.
+  /// \tparam Condition Callable returning if a cell fulfills the condition.
+  /// \param cellId Cell to be checked.
+  /// \param dir Direction to be checked.
+  /// \param condition Condition of the adjacent cell.
+  /// \return The adjacent cell fulfills the condition.
+  template <class Condition>
+  [[nodiscard]] auto adjacentTo(GInt cellId, const GInt dir, Condition&& condition) const -> GBool {
+    while(cellId != INVALID_CELLID) {
+      const GInt nghbrId = m_nghbrIds(cellId, dir);
+      if(nghbrId != INVALID_CELLID) {
+        return condition(nghbrId);
+      }
+      // the neighbor would be a sibling
+      if((m_coordinate[cellId][dir / 2] & 1U) != static_cast<GUint32>(dir % 2)) {
+        return false;
+      }
+      cellId = parent(cellId);
+    }
+    return false;
+  }
+
+  /// Grid is distributed among several MPI ranks.
+  [[nodiscard]] auto distributed() const -> GBool { return m_domainOffsets.size() > 2; }
+
   [[nodiscard]] auto pointIsInside(const Point<NDIM>& x) const -> GBool { return geometry()->pointIsInside(x); }
 
   [[nodiscard]] auto cellHasCut(const GInt cellId) const -> GBool {
@@ -618,20 +2107,21 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     ASSERT(from >= 0, "Invalid from!");
     ASSERT(to >= 0, "Invalid to!");
 
-    property(to)     = property(from);
-    level(to)        = level(from);
-    center(to)       = center(from);
-    globalId(to)     = globalId(from);
-    parent(to)       = parent(from);
-    m_nghbrIds[to]   = m_nghbrIds[from];
-    m_childIds[to]   = m_childIds[from];
-    m_noChildren[to] = m_noChildren[from];
+    assignProperties(to, properties(from));
+    level(to)         = level(from);
+    m_coordinate[to]  = m_coordinate[from];
+    globalId(to)      = globalId(from);
+    parent(to)        = parent(from);
+    m_noChildren[to]  = m_noChildren[from];
+    m_rfnDistance[to] = m_rfnDistance[from];
+    m_nghbrIds.copy(from, to);
+    m_childIds.copy(from, to);
 
     for(GInt dir = 0; dir < cartesian::maxNoNghbrs<NDIM>(); ++dir) {
-      if(m_nghbrIds[to].n[dir] != INVALID_CELLID) {
-        m_nghbrIds[m_nghbrIds[to].n[dir]].n[cartesian::oppositeDir(dir)] = to;
+      if(m_nghbrIds(to, dir) != INVALID_CELLID) {
+        m_nghbrIds(m_nghbrIds(to, dir), cartesian::oppositeDir(dir)) = to;
       }
-      m_nghbrIds[from].n[dir] = INVALID_CELLID;
+      m_nghbrIds(from, dir) = INVALID_CELLID;
     }
 
     if(parent(to) != INVALID_CELLID) {
@@ -639,48 +2129,120 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     }
 
     for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
-      if(m_childIds[to].c[childId] != INVALID_CELLID) {
-        parent(m_childIds[to].c[childId]) = to;
+      if(m_childIds(to, childId) != INVALID_CELLID) {
+        parent(m_childIds(to, childId)) = to;
       }
     }
   }
 
-  void swapCell(GInt idA, GInt idB) {
-    copyCell(idA, capacity() - 1);
-    copyCell(idB, idA);
-    copyCell(capacity() - 1, idB);
-  }
-
   void updateParent(const GInt parentId, const GInt oldChildCellId, const GInt newChildCellId) {
     ASSERT(parentId >= 0, "Invalid parentId!");
     for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
-      if(m_childIds[parentId].c[childId] == oldChildCellId) {
-        m_childIds[parentId].c[childId] = newChildCellId;
+      if(m_childIds(parentId, childId) == oldChildCellId) {
+        m_childIds(parentId, childId) = newChildCellId;
         return;
       }
     }
   }
 
+  /// Hilbert index of the cell up to the given level of the Hilbert curve.
+  /// The cell coordinates are encoded on the finest level such that the curves of all levels are nested.
+  /// \param cellId Cell of which the index is determined.
+  /// \param hilbertLevel Number of iterations of the Hilbert curve.
+  /// \return The Hilbert index.
+  [[nodiscard]] auto hilbertId(const GInt cellId, const GInt hilbertLevel) const -> GInt {
+    ASSERT(NDIM * hilbertLevel < 64, "Hilbert index exceeds 63 bits!");
+    const GInt                bits  = maxLvl();
+    const GInt                shift = bits - std::to_integer<GInt>(level(cellId));
+    hilbert::Coordinate<NDIM> x;
+    for(GInt dir = 0; dir < NDIM; ++dir) {
+      x[dir] = m_coordinate[cellId][dir] << shift;
+    }
+    if(NDIM * bits < 64) {
+      return static_cast<GInt>(hilbert::encode<NDIM, GUint>(x, bits) >> (NDIM * (bits - hilbertLevel)));
+    }
+    return static_cast<GInt>(hilbert::encode<NDIM, GUint128>(x, bits) >> (NDIM * (bits - hilbertLevel)));
+  }
+
+  /// Accumulate the values of the subtree of each cell bottom-up, i.e., afterwards each cell holds the sum of its own
+  /// value and the values of all its offsprings. Requires valid level offsets.
+  /// \tparam T Type of the values.
+  /// \param values Value of each cell.
+  template <typename T>
+  void accumulateSubtrees(std::vector<T>& values) const {
+    for(GInt lvl = currentHighestLvl() - 1; lvl >= partitionLvl(); --lvl) {
+      const GInt firstCellOfLvl = m_levelOffsets[lvl].begin;
+      const GInt lastCellOfLvl  = m_levelOffsets[lvl].end;
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(firstCellOfLvl, lastCellOfLvl, values)
+#endif
+      for(GInt cellId = firstCellOfLvl; cellId < lastCellOfLvl; ++cellId) {
+        for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
+          if(m_childIds(cellId, childId) != INVALID_CELLID) {
+            values[cellId] += values[m_childIds(cellId, childId)];
+          }
+        }
+      }
+    }
+  }
+
+  /// Children of the cell ordered along the Hilbert curve.
+  /// \param cellId Parent cell.
+  /// \param children The ordered children.
+  /// \return Number of children.
+  auto hilbertOrderedChildren(const GInt cellId, ChildListType& children) const -> GInt {
+    const GInt                                         hilbertLevel = std::to_integer<GInt>(level(cellId)) + 1;
+    std::array<GInt, cartesian::maxNoChildren<NDIM>()> keys{};
+    GInt                                               noChildren = 0;
+    for(GInt childId = 0; childId < cartesian::maxNoChildren<NDIM>(); ++childId) {
+      const GInt childCellId = m_childIds(cellId, childId);
+      if(childCellId == INVALID_CELLID) {
+        continue;
+      }
+      // insertion sort by the Hilbert index
+      const GInt key = hilbertId(childCellId, hilbertLevel);
+      GInt       pos = noChildren++;
+      for(; pos > 0 && keys[pos - 1] > key; --pos) {
+        keys[pos]     = keys[pos - 1];
+        children[pos] = children[pos - 1];
+      }
+      keys[pos]     = key;
+      children[pos] = childCellId;
+    }
+    return noChildren;
+  }
+
+  /// Check if the cell coordinates of two cells on the same level are adjacent in the given direction.
+  /// \param a Cell coordinates of the cell.
+  /// \param b Cell coordinates of the neighbor.
+  /// \param dir Direction of the neighbor.
+  /// \return Cells are neighbors.
+  static auto isNeighborCoordinate(const CellCoordinate<NDIM>& a, const CellCoordinate<NDIM>& b, const GInt dir) -> GBool {
+    for(GInt d = 0; d < NDIM; ++d) {
+      const GInt diff     = static_cast<GInt>(b[d]) - static_cast<GInt>(a[d]);
+      const GInt expected = d == dir / 2 ? 2 * (dir % 2) - 1 : 0;
+      if(diff != expected) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   void reorderHilbertCurve() {
     logger << SP2 << "+ reordering grid based on Hilbert curve" << std::endl;
     std::cout << SP2 << "+ reordering grid based on Hilbert curve" << std::endl;
 
-    Point<NDIM>       centerOfGravity = Point<NDIM>(cog().data());
     std::vector<GInt> hilbertIds(size());
     std::vector<GInt> index(size());
-    std::vector<GInt> pos(size());
-    std::vector<GInt> rev(size());
     // generate indices
     std::iota(index.begin(), index.end(), 0);
-    std::iota(pos.begin(), pos.end(), 0);
-    std::iota(rev.begin(), rev.end(), 0);
 
-    GInt hilbertLevel = partitionLvl();
+    const GInt hilbertLevel = partitionLvl();
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(hilbertIds, hilbertLevel)
+#endif
     for(GInt cellId = 0; cellId < size(); ++cellId) {
-      // Normalization to unit cube
-      // array() since there is no scalar addition for vectors...
-      Point<NDIM> x      = ((center(cellId) - centerOfGravity).array() + HALF * lengthOnLvl(0)) / lengthOnLvl(0);
-      hilbertIds[cellId] = hilbert::index<NDIM>(x, hilbertLevel);
+      hilbertIds[cellId] = hilbertId(cellId, hilbertLevel);
     }
     if(DEBUG_LEVEL >= Debug_Level::debug) {
       logger << "checking duplicated Hilbert Ids" << std::endl;
@@ -702,28 +2264,19 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     }
 
     // sort index by hilbertId
-    std::sort(index.begin(), index.end(), [&](int A, int B) -> bool { return hilbertIds[A] < hilbertIds[B]; });
+    algorithm::radixSort(hilbertIds, index, NDIM * hilbertLevel);
 
+    // move each cell to its position on the Hilbert curve
+    m_newCellIds.resize(size());
     for(GInt id = 0; id < size(); ++id) {
-      const GInt hilbertPos = index[id];
-      if(id != hilbertPos) {
-        // is not already in correct position due to swapping
-        if(id != pos[hilbertPos]) {
-          swapCell(id, pos[hilbertPos]);
-        }
-        GInt tmp             = rev[id];
-        rev[pos[hilbertPos]] = tmp;
-        pos[tmp]             = pos[hilbertPos];
-      }
+      m_newCellIds[index[id]] = id;
     }
+    reorderCells(0, size(), size());
 
     if(DEBUG_LEVEL > Debug_Level::debug) {
       std::fill(hilbertIds.begin(), hilbertIds.end(), 0);
       for(GInt cellId = 0; cellId < size(); ++cellId) {
-        // Normalization to unit cube
-        // array() since there is no scalar addition for vectors...
-        Point<NDIM> x      = ((center(cellId) - centerOfGravity).array() + HALF * lengthOnLvl(0)) / lengthOnLvl(0);
-        hilbertIds[cellId] = hilbert::index<NDIM>(x, hilbertLevel);
+        hilbertIds[cellId] = hilbertId(cellId, hilbertLevel);
       }
       for(GInt cellId = 1; cellId < size(); ++cellId) {
         if(hilbertIds[cellId - 1] > hilbertIds[cellId]) {
@@ -734,10 +2287,40 @@ class CartesianGridGen : public BaseCartesianGrid<DEBUG_LEVEL, NDIM> {
     }
   }
 
-  std::vector<LevelOffsetType>    m_levelOffsets{};
-  std::vector<GInt>               m_noChildren{};
-  std::vector<NeighborList<NDIM>> m_nghbrIds{};
-  std::vector<ChildList<NDIM>>    m_childIds{};
-  std::vector<GInt>               m_rfnDistance{};
+  std::vector<LevelOffsetType>           m_levelOffsets{};
+  FirstTouchVector<GInt>                 m_noChildren{};
+  NeighborConnectivity                   m_nghbrIds{};
+  ChildConnectivity                      m_childIds{};
+  FirstTouchVector<GInt>                 m_rfnDistance{};
+  FirstTouchVector<CellCoordinate<NDIM>> m_coordinate{};
+  // lower corner of the uniform grid of each level
+  std::vector<Point<NDIM>> m_lvlOrigin{};
+
+  // capacity grows on demand up to m_maxCapacity (no limit if negative)
+  GBool m_growable    = false;
+  GInt  m_maxCapacity = -1;
+
+  // scratch storage for the positions of the children of the marked cells
+  std::vector<GInt> m_refineOffsets{};
+  // scratch storage for the region of each non-boundary cell (identified by its first cell) of a level
+  std::vector<GInt> m_regionIds{};
+  // scratch storage for the new position of the cells when reordering or removing cells
+  std::vector<GInt> m_newCellIds{};
+  // range of the subtree of each partitioning cell for a depth-first ordered grid
+  std::vector<GInt> m_partitionCellOffsets{};
+  // range of the partitioning cells owned by each domain
+  std::vector<GInt> m_domainOffsets{};
+  // partition cells of the partitioned grid along the Hilbert curve
+  std::vector<GInt> m_partitionCells{};
+  // range of the partition cells of each domain of the partitioned grid
+  std::vector<GInt> m_partitionOffsets{};
+  // domain of each partition cell
+  std::vector<GInt> m_partitionDomains{};
+  // geometry elements cutting the boundary cells of the last refined level
+  CutElements m_cutElements{};
+  // number of cells classified by their parent without checking the geometry
+  GInt m_noSkippedGeometryChecks = 0;
+  // criterion of the feature-based refinement of the boundary cells
+  FeatureRefinement m_featureRefinement{};
 };
 #endif // GRIDGENERATOR_CARTESIANGRID_GENERATION_H
@@ -0,0 +1,423 @@
+#ifndef GRIDGENERATOR_CELL_LAYOUT_H
+#define GRIDGENERATOR_CELL_LAYOUT_H
+
+#include <algorithm>
+#include <array>
+#include <config.h>
+#include <limits>
+#include <sfcmm_common.h>
+#include <type_traits>
+#include <vector>
+#include "gridcell_properties.h"
+
+/// Storage of the cell ids of the connectivity of a cell (e.g., its neighbors or children).
+enum class ConnectivityStorage {
+  // one record with all ids of a cell
+  packed,
+  // a separate array for each position, i.e., all cells of one direction are contiguous
+  split
+};
+
+/// Layout policy of the cell connectivity of the grids.
+/// \tparam INDEX Integer type of the stored cell ids.
+/// \tparam STORAGE Storage of the ids of a cell.
+template <typename INDEX, ConnectivityStorage STORAGE>
+struct CellLayout {
+  static_assert(std::is_integral_v<INDEX> && std::is_signed_v<INDEX>, "Cell ids need to be signed to store INVALID_CELLID");
+
+  using IndexType                              = INDEX;
+  static constexpr ConnectivityStorage storage = STORAGE;
+
+  /// Largest number of cells that can be addressed with this layout.
+  static constexpr auto maxNoCells() -> GInt { return static_cast<GInt>(std::numeric_limits<INDEX>::max()); }
+};
+
+#ifdef GRIDGEN_64BIT_CELLIDS
+using DefaultCellIndex = GInt;
+#else
+using DefaultCellIndex = GInt32;
+#endif
+
+#ifdef GRIDGEN_SPLIT_CONNECTIVITY
+using DefaultCellLayout = CellLayout<DefaultCellIndex, ConnectivityStorage::split>;
+#else
+using DefaultCellLayout = CellLayout<DefaultCellIndex, ConnectivityStorage::packed>;
+#endif
+
+/// Alignment of a packed record of cell ids, i.e., the largest power of two dividing the size of the record (at most a
+/// cache line).
+/// \param recordSize Size of the record in bytes.
+/// \param alignment Minimum alignment of the record.
+constexpr auto connectivityRecordAlignment(const std::size_t recordSize, std::size_t alignment) -> std::size_t {
+  constexpr std::size_t cacheLineSize = 64;
+  while(alignment < cacheLineSize && recordSize % (2 * alignment) == 0) {
+    alignment *= 2;
+  }
+  return alignment;
+}
+
+/// Fixed number of cell ids per cell (INVALID_CELLID if not set) stored according to the layout policy. Packed records are
+/// aligned to the largest power of two dividing their size (at most a cache line), so records of power-of-two size never
+/// straddle a cache line and no padding is added.
+/// \tparam LAYOUT Layout policy (see CellLayout).
+/// \tparam N Number of ids per cell.
+template <typename LAYOUT, GInt N>
+class CellConnectivity {
+ public:
+  using IndexType = typename LAYOUT::IndexType;
+
+ private:
+  struct alignas(connectivityRecordAlignment(N * sizeof(IndexType), alignof(IndexType))) Record {
+    std::array<IndexType, N> ids;
+  };
+
+  static constexpr GBool packed = LAYOUT::storage == ConnectivityStorage::packed;
+
+ public:
+  /// Change the number of cells. Added cells have no connections.
+  /// \param capacity Number of cells.
+  void resize(const GInt capacity) {
+    if constexpr(packed) {
+      m_records.resize(capacity, invalidRecord());
+    } else {
+      for(auto& ids : m_ids) {
+        ids.resize(capacity, static_cast<IndexType>(INVALID_CELLID));
+      }
+    }
+  }
+
+  void clear() {
+    if constexpr(packed) {
+      m_records.clear();
+    } else {
+      for(auto& ids : m_ids) {
+        ids.clear();
+      }
+    }
+  }
+
+  [[nodiscard]] inline auto operator()(const GInt cellId, const GInt pos) -> IndexType& {
+    if constexpr(packed) {
+      return m_records[cellId].ids[pos];
+    } else {
+      return m_ids[pos][cellId];
+    }
+  }
+
+  [[nodiscard]] inline auto operator()(const GInt cellId, const GInt pos) const -> GInt {
+    if constexpr(packed) {
+      return m_records[cellId].ids[pos];
+    } else {
+      return m_ids[pos][cellId];
+    }
+  }
+
+  /// Remove all connections of the cell.
+  void invalidate(const GInt cellId) {
+    if constexpr(packed) {
+      m_records[cellId] = invalidRecord();
+    } else {
+      for(auto& ids : m_ids) {
+        ids[cellId] = static_cast<IndexType>(INVALID_CELLID);
+      }
+    }
+  }
+
+  /// Remove all connections of the cells [begin, end).
+  void invalidate(const GInt begin, const GInt end) {
+    if constexpr(packed) {
+      memory::parallelFill(m_records, begin, end, invalidRecord());
+    } else {
+      for(auto& ids : m_ids) {
+        memory::parallelFill(ids, begin, end, static_cast<IndexType>(INVALID_CELLID));
+      }
+    }
+  }
+
+  /// Copy all connections of a cell to another cell.
+  void copy(const GInt from, const GInt to) {
+    if constexpr(packed) {
+      m_records[to] = m_records[from];
+    } else {
+      for(auto& ids : m_ids) {
+        ids[to] = ids[from];
+      }
+    }
+  }
+
+  /// Take over the connections of a storage with fewer ids per cell, e.g., the neighbors of the generated grid for a grid
+  /// with diagonal neighbors. The additional ids are not set. Arrays of the same size are moved without copying, otherwise
+  /// the records are converted and the source is released directly afterwards.
+  /// \tparam M Number of ids per cell of the source.
+  /// \param other Source of the connections (empty afterwards).
+  template <GInt M>
+  void assign(CellConnectivity<LAYOUT, M>&& other) {
+    static_assert(M <= N, "The source has more ids per cell than the storage!");
+    if constexpr(packed && M == N) {
+      m_records = std::move(other.m_records);
+    } else if constexpr(packed) {
+      const GInt capacity = static_cast<GInt>(other.m_records.size());
+      m_records.assign(capacity, invalidRecord());
+#ifdef _OPENMP
+#pragma omp parallel for default(none) shared(capacity, other)
+#endif
+      for(GInt cellId = 0; cellId < capacity; ++cellId) {
+        std::copy_n(other.m_records[cellId].ids.begin(), M, m_records[cellId].ids.begin());
+      }
+      other.m_records = {};
+    } else {
+      const GInt capacity = static_cast<GInt>(other.m_ids[0].size());
+      for(GInt pos = 0; pos < M; ++pos) {
+        m_ids[pos] = std::move(other.m_ids[pos]);
+      }
+      for(GInt pos = M; pos < N; ++pos) {
+        m_ids[pos].assign(capacity, static_cast<IndexType>(INVALID_CELLID));
+      }
+    }
+  }
+
+  /// Number of arrays in which the ids are stored (1 for packed records).
+  static constexpr auto noArrays() -> GInt { return packed ? 1 : N; }
+
+  /// Element of the array of the storage, i.e., the record of the cell or a single id, e.g., to move whole records at once.
+  /// \param arrayId Id of the array (see noArrays()).
+  /// \param cellId Id of the cell.
+  [[nodiscard]] inline auto element(const GInt arrayId, const GInt cellId) -> auto& {
+    if constexpr(packed) {
+      return m_records[cellId];
+    } else {
+      return m_ids[arrayId][cellId];
+    }
+  }
+
+  /// Memory required for each cell in bytes.
+  static constexpr auto memorySizePerCell() -> GInt {
+    if constexpr(packed) {
+      return sizeof(Record);
+    } else {
+      return N * sizeof(IndexType);
+    }
+  }
+
+ private:
+  template <typename, GInt>
+  friend class CellConnectivity;
+
+  static auto invalidRecord() -> Record {
+    Record record{};
+    record.ids.fill(static_cast<IndexType>(INVALID_CELLID));
+    return record;
+  }
+
+  FirstTouchVector<Record>                                m_records{};
+  std::array<FirstTouchVector<IndexType>, packed ? 0 : N> m_ids{};
+};
+
+/// Storage of the cell properties.
+enum class PropertyStorage {
+  // one bitset per cell
+  bitset,
+  // one bit vector per property (bit planes), i.e., a property of 64 cells is scanned at once
+  planes
+};
+
+#ifdef GRIDGEN_PROPERTY_PLANES
+static constexpr PropertyStorage DEFAULT_PROPERTY_STORAGE = PropertyStorage::planes;
+#else
+static constexpr PropertyStorage DEFAULT_PROPERTY_STORAGE = PropertyStorage::bitset;
+#endif
+
+/// Properties of the cells (see CellProperties). Besides the access of single cells, the storage provides scans of a
+/// property over a range of cells, which operate on whole words of 64 cells for the bit planes.
+/// \tparam STORAGE Storage of the properties.
+template <PropertyStorage STORAGE>
+class CellPropertyStorage {
+ public:
+  using BitsetType = grid::cell::BitsetType;
+
+ private:
+  static constexpr GBool planes = STORAGE == PropertyStorage::planes;
+
+ public:
+  /// Change the number of cells. Added cells have no properties set.
+  /// \param capacity Number of cells.
+  void resize(const GInt capacity) {
+    if constexpr(planes) {
+      for(auto& plane : m_planes) {
+        plane.resize(capacity);
+      }
+    } else {
+      m_bitsets.resize(capacity);
+    }
+    m_capacity = capacity;
+  }
+
+  void clear() {
+    if constexpr(planes) {
+      for(auto& plane : m_planes) {
+        plane.clear();
+      }
+    } else {
+      m_bitsets.clear();
+    }
+    m_capacity = 0;
+  }
+
+  [[nodiscard]] auto capacity() const -> GInt { return m_capacity; }
+
+  [[nodiscard]] inline auto operator()(const GInt cellId, const CellProperties p) -> auto {
+    if constexpr(planes) {
+      return m_planes[grid::cell::p(p)][cellId];
+    } else {
+      return m_bitsets[cellId][grid::cell::p(p)];
+    }
+  }
+
+  [[nodiscard]] inline auto operator()(const GInt cellId, const CellProperties p) const -> GBool {
+    if constexpr(planes) {
+      return m_planes[grid::cell::p(p)][cellId];
+    } else {
+      return m_bitsets[cellId][grid::cell::p(p)];
+    }
+  }
+
+  /// All properties of a cell.
+  [[nodiscard]] auto get(const GInt cellId) const -> BitsetType {
+    if constexpr(planes) {
+      BitsetType bitset;
+      for(GInt p = 0; p < grid::cell::p(CellProperties::NumProperties); ++p) {
+        bitset[p] = m_planes[p][cellId];
+      }
+      return bitset;
+    } else {
+      return m_bitsets[cellId];
+    }
+  }
+
+  /// Set all properties of a cell.
+  void set(const GInt cellId, const BitsetType& bitset) {
+    if constexpr(planes) {
+      for(GInt p = 0; p < grid::cell::p(CellProperties::NumProperties); ++p) {
+        m_planes[p].set(cellId, bitset[p]);
+      }
+    } else {
+      m_bitsets[cellId] = bitset;
+    }
+  }
+
+  /// Reset all properties of the cells [begin, end).
+  void reset(const GInt begin, const GInt end) {
+    if constexpr(planes) {
+      for(auto& plane : m_planes) {
+        plane.fill(begin, end, false);
+      }
+    } else {
+      memory::parallelFill(m_bitsets, begin, end, BitsetType());
+    }
+  }
+
+  /// Number of cells of the range [begin, end) with the property.
+  [[nodiscard]] auto count(const CellProperties p, const GInt begin, const GInt end) const -> GInt {
+    if constexpr(planes) {
+      return m_planes[grid::cell::p(p)].count(begin, end);
+    } else {
+      GInt noCells = 0;
+      for(GInt cellId = begin; cellId < end; ++cellId) {
+        noCells += static_cast<GInt>(m_bitsets[cellId][grid::cell::p(p)]);
+      }
+      return noCells;
+    }
+  }
+
+  /// Number of cells of the range [begin, end) with both properties p and q.
+  [[nodiscard]] auto countAnd(const CellProperties p, const CellProperties q, const GInt begin, const GInt end) const -> GInt {
+    if constexpr(planes) {
+      const BitVector& planeP = m_planes[grid::cell::p(p)];
+      const BitVector& planeQ = m_planes[grid::cell::p(q)];
+      return bits::count(begin, end, [&](const GInt wordId) { return planeP.word(wordId) & planeQ.word(wordId); });
+    } else {
+      GInt noCells = 0;
+      for(GInt cellId = begin; cellId < end; ++cellId) {
+        noCells += static_cast<GInt>(m_bitsets[cellId][grid::cell::p(p)] && m_bitsets[cellId][grid::cell::p(q)]);
+      }
+      return noCells;
+    }
+  }
+
+  /// Number of cells of the range [begin, end) with the property p but without the property q.
+  [[nodiscard]] auto countAndNot(const CellProperties p, const CellProperties q, const GInt begin, const GInt end) const -> GInt {
+    if constexpr(planes) {
+      const BitVector& planeP = m_planes[grid::cell::p(p)];
+      const BitVector& planeQ = m_planes[grid::cell::p(q)];
+      return bits::count(begin, end, [&](const GInt wordId) { return planeP.word(wordId) & ~planeQ.word(wordId); });
+    } else {
+      GInt noCells = 0;
+      for(GInt cellId = begin; cellId < end; ++cellId) {
+        noCells += static_cast<GInt>(m_bitsets[cellId][grid::cell::p(p)] && !m_bitsets[cellId][grid::cell::p(q)]);
+      }
+      return noCells;
+    }
+  }
+
+  /// Set the property of the cells [begin, end) to the given value.
+  void fill(const CellProperties p, const GInt begin, const GInt end, const GBool value) {
+    if constexpr(planes) {
+      m_planes[grid::cell::p(p)].fill(begin, end, value);
+    } else {
+      for(GInt cellId = begin; cellId < end; ++cellId) {
+        m_bitsets[cellId][grid::cell::p(p)] = value;
+      }
+    }
+  }
+
+  /// Set the property target for all cells of the range [begin, end) with the property source (target |= source).
+  void setWhere(const CellProperties target, const CellProperties source, const GInt begin, const GInt end) {
+    if constexpr(planes) {
+      BitVector&       planeTarget = m_planes[grid::cell::p(target)];
+      const BitVector& planeSource = m_planes[grid::cell::p(source)];
+      for(GInt first = begin; first < end;) {
+        const GInt wordId = first / bits::WORD_SIZE;
+        const GInt last   = std::min((wordId + 1) * bits::WORD_SIZE, end);
+        planeTarget.word(wordId) |= planeSource.word(wordId) & bits::wordMask(first, last);
+        first = last;
+      }
+    } else {
+      for(GInt cellId = begin; cellId < end; ++cellId) {
+        if(m_bitsets[cellId][grid::cell::p(source)]) {
+          m_bitsets[cellId][grid::cell::p(target)] = true;
+        }
+      }
+    }
+  }
+
+  /// Call the functor for each cell of the range [begin, end) with the property (in ascending order).
+  template <class Functor>
+  void forEach(const CellProperties p, const GInt begin, const GInt end, Functor&& fn) const {
+    if constexpr(planes) {
+      const BitVector& plane = m_planes[grid::cell::p(p)];
+      bits::forEach(begin, end, [&](const GInt wordId) { return plane.word(wordId); }, fn);
+    } else {
+      for(GInt cellId = begin; cellId < end; ++cellId) {
+        if(m_bitsets[cellId][grid::cell::p(p)]) {
+          fn(cellId);
+        }
+      }
+    }
+  }
+
+  /// Memory required for each cell in bytes.
+  static constexpr auto memorySizePerCell() -> GInt {
+    if constexpr(planes) {
+      return (grid::cell::p(CellProperties::NumProperties) + binary::BYTE_SIZE - 1) / binary::BYTE_SIZE;
+    } else {
+      return sizeof(BitsetType);
+    }
+  }
+
+ private:
+  GInt                                                                             m_capacity = 0;
+  FirstTouchVector<BitsetType>                                                     m_bitsets{};
+  std::array<BitVector, planes ? grid::cell::p(CellProperties::NumProperties) : 0> m_planes{};
+};
+
+#endif // GRIDGENERATOR_CELL_LAYOUT_H
@@ -94,6 +94,20 @@ inline void writePointsCSV(const GString& fileName, const GInt noValues, const s
   writePointsCSV<DIM>(fileName, noValues, coordinates, &filterAll, index, values);
 }
 
+/// Number of characters of a coordinate written with digits10 precision (including sign, decimal point and separator).
+static constexpr GInt coordinateChars = std::numeric_limits<double>::digits10 + 4;
+/// Assumed number of characters of a value (short integers such as the level, including the separator).
+static constexpr GInt valueChars = 3;
+
+/// Estimate the size of a point-based CSV-file written by writePointsCSV().
+/// \tparam DIM Dimensionality of the points
+/// \param noPoints Number of points to write.
+/// \param noValues Number of values per point.
+/// \return Estimated file size in bytes.
+template <GInt DIM>
+inline auto estimatePointsCSVSize(const GInt noPoints, const GInt noValues) -> GInt {
+  return noPoints * (DIM * coordinateChars + noValues * valueChars);
+}
 } // namespace ASCII
 
 /// Namespace to write ParaView files in  VTK format.
@@ -384,6 +398,18 @@ inline void writePoints(const GString& fileName, const GInt maxNoValues, const s
   pointFile << point_data_footer();
   pointFile << footer();
 }
+
+/// Estimate the size of a point-based VTK-file written by writePoints().
+/// \tparam DIM Dimensionality of the points
+/// \param noPoints Number of points to write.
+/// \param noValues Number of values per point.
+/// \return Estimated file size in bytes.
+template <GInt DIM>
+inline auto estimatePointsSize(const GInt noPoints, const GInt noValues) -> GInt {
+  // the points are padded to 3D and each point is written as a vertex
+  const GInt idChars = static_cast<GInt>(to_string(noPoints).size()) + 1;
+  return noPoints * (DIM * ::ASCII::coordinateChars + (3 - DIM) * 4 + idChars + noValues * ::ASCII::valueChars);
+}
 } // namespace ASCII
 
 /// Namespace for functions to write VTK in binary format.
@@ -505,6 +531,26 @@ inline void writePoints(const GString& fileName, const GInt maxNoValues, const s
   pointFile << footer();
   pointFile.close();
 }
+
+/// Size of the base64 encoded data written by writeBinary().
+/// \tparam T Type of the data.
+/// \param length Number of values.
+/// \return Number of characters.
+template <typename T>
+inline auto binarySize(const GInt length) -> GInt {
+  return 4 * ((binary::BYTE_SIZE + static_cast<GInt>(sizeof(T)) * length + 2) / 3);
+}
+
+/// Estimate the size of a point-based VTK-file written by writePoints(). Only the size of the XML markup is estimated.
+/// \tparam DIM Dimensionality of the points
+/// \param noPoints Number of points to write.
+/// \param noValues Number of (integer) values per point.
+/// \return Estimated file size in bytes.
+template <GInt DIM>
+inline auto estimatePointsSize(const GInt noPoints, const GInt noValues) -> GInt {
+  static constexpr GInt markupSize = 1024;
+  return markupSize + binarySize<GFloat>(3 * noPoints) + binarySize<GInt>(noPoints) + noValues * binarySize<GInt32>(noPoints);
+}
 } // namespace BINARY
 } // namespace VTK
 
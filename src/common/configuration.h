@@ -101,6 +101,19 @@ class Configuration {
       setupUnusedTracking();
       configFileStream.close();
     }
+
+    // 2. communicate the configuration to all other processes
+    if(!MPI::isSerial()) {
+      GString configString = MPI::isRoot() ? m_config.dump() : "";
+      GInt    length       = static_cast<GInt>(configString.size());
+      MPI_Bcast(&length, 1, MPI_INT64_T, 0, MPI_COMM_WORLD);
+      configString.resize(length);
+      MPI_Bcast(configString.data(), static_cast<int>(length), MPI_CHAR, 0, MPI_COMM_WORLD);
+      if(!MPI::isRoot()) {
+        m_config = json::parse(configString);
+        setupUnusedTracking();
+      }
+    }
   }
 
   /// Get a required configuration value (exit if it doesn't exist)
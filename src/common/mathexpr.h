@@ -1,14 +1,26 @@
 #ifndef LBM_MATHEXPR_H
 #define LBM_MATHEXPR_H
+#include <memory>
 #include <utility>
+#include <vector>
 #include <sfcmm_common.h>
 #include "exprtk.h"
+#include "term.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
+/// Expression of the coordinates x, y and z and optional additional parameters. The variables of the expression are
+/// stored in the instance, hence, an instance must not be evaluated by several threads concurrently (see
+/// ThreadMathExpression).
 template <GInt NDIM>
 class MathExpression {
  public:
   MathExpression() = default;
-  MathExpression(GString expr_string) : m_expr_str(std::move(expr_string)) {
+  /// \param expr_string Expression to be compiled.
+  /// \param parameters Names of additional variables of the expression.
+  MathExpression(GString expr_string, const std::vector<GString>& parameters = {})
+    : m_expr_str(std::move(expr_string)), m_parameters(parameters.size(), 0) {
     m_sym.add_variable("x", m_params[0]);
     if constexpr(NDIM > 1) {
       m_sym.add_variable("y", m_params[1]);
@@ -16,11 +28,21 @@ class MathExpression {
         m_sym.add_variable("z", m_params[2]);
       }
     }
+    for(GUint id = 0; id < parameters.size(); ++id) {
+      m_sym.add_variable(parameters[id], m_parameters[id]);
+    }
     m_sym.add_constants();
 
     m_expr.register_symbol_table(m_sym);
-    m_parse.compile(m_expr_str, m_expr);
+    if(!m_parse.compile(m_expr_str, m_expr)) {
+      TERMM(-1, "Invalid expression \"" + m_expr_str + "\": " + m_parse.error());
+    }
   }
+  ~MathExpression()                                        = default;
+  MathExpression(const MathExpression&)                    = delete;
+  MathExpression(MathExpression&&)                         = delete;
+  auto operator=(const MathExpression&) -> MathExpression& = delete;
+  auto operator=(MathExpression&&) -> MathExpression&      = delete;
 
   auto eval(const std::array<GDouble, NDIM>& x) -> GDouble {
     m_params = x;
@@ -34,11 +56,26 @@ class MathExpression {
     return m_expr.value();
   }
 
+  /// Evaluate the expression for several points with the current values of the additional parameters.
+  /// \param noPoints Number of points.
+  /// \param x Coordinates of the points.
+  /// \param values Values of the expression at the points.
+  void eval(const GInt noPoints, const VectorD<NDIM>* x, GDouble* values) {
+    for(GInt id = 0; id < noPoints; ++id) {
+      values[id] = eval(x[id]);
+    }
+  }
+
+  /// Value of an additional parameter (in the order of their definition).
+  auto parameter(const GInt id) -> GDouble& { return m_parameters[id]; }
+
   auto empty() -> GBool { return m_expr_str.empty(); }
 
  private:
   GString                   m_expr_str;
   std::array<GDouble, NDIM> m_params;
+  // the variables are referenced by the symbol table, i.e., the storage must not be reallocated
+  std::vector<GDouble> m_parameters{};
 
   // storage for exprtk
   exprtk::symbol_table<GDouble> m_sym;
@@ -46,4 +83,37 @@ class MathExpression {
   exprtk::parser<GDouble>       m_parse;
 };
 
+/// An expression compiled once for each OpenMP thread, such that the threads can evaluate it concurrently.
+template <GInt NDIM>
+class ThreadMathExpression {
+ public:
+  /// \param expr_string Expression to be compiled.
+  /// \param parameters Names of additional variables of the expression.
+  ThreadMathExpression(const GString& expr_string, const std::vector<GString>& parameters = {}) {
+#ifdef _OPENMP
+    const GInt noThreads = omp_get_max_threads();
+#else
+    const GInt noThreads = 1;
+#endif
+    for(GInt threadId = 0; threadId < noThreads; ++threadId) {
+      m_expressions.emplace_back(std::make_unique<MathExpression<NDIM>>(expr_string, parameters));
+    }
+  }
+
+  /// Instance of the calling thread. The instances are created for the maximum number of threads at construction.
+  auto local() const -> MathExpression<NDIM>& {
+#ifdef _OPENMP
+    const GInt threadId = omp_get_thread_num();
+    ASSERT(threadId < static_cast<GInt>(m_expressions.size()),
+           "No expression instance for thread " + std::to_string(threadId) + ", the number of threads has been increased!");
+    return *m_expressions[threadId];
+#else
+    return *m_expressions[0];
+#endif
+  }
+
+ private:
+  std::vector<std::unique_ptr<MathExpression<NDIM>>> m_expressions{};
+};
+
 #endif // LBM_MATHEXPR_H
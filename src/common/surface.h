@@ -20,13 +20,15 @@ class SurfaceInterface {
 };
 
 // 3D: Surface 2D: Line 1D: Point
-template <Debug_Level DEBUG_LEVEL, GInt NDIM>
+template <Debug_Level DEBUG_LEVEL, GInt NDIM, typename LAYOUT = DefaultCellLayout>
 class Surface : public SurfaceInterface {
  public:
-  explicit Surface(CartesianGridData<NDIM> data, grid::cell::BitsetType* properties) : m_grid(data), m_properties(properties){};
+  using PropertyStorageType = CellPropertyStorage<DEFAULT_PROPERTY_STORAGE>;
+
+  explicit Surface(CartesianGridData<NDIM, LAYOUT> data, PropertyStorageType* properties) : m_grid(data), m_properties(properties){};
   ~Surface() override = default;
 
-  Surface(const Surface<DEBUG_LEVEL, NDIM>& copy) = default;
+  Surface(const Surface& copy) = default;
 
 
   Surface(Surface&&)                              = delete;
@@ -81,7 +83,7 @@ class Surface : public SurfaceInterface {
 
   [[nodiscard]] auto cellLength(const GInt cellId) const -> GDouble { return m_grid.cellLength(cellId); }
 
-  auto grid() const -> CartesianGridData<NDIM> { return m_grid; }
+  auto grid() const -> CartesianGridData<NDIM, LAYOUT> { return m_grid; }
 
   [[nodiscard]] auto neighbor(const GInt cellId, const GInt dir) const -> GInt override {
     //    if(DEBUG_LEVEL >= Debug_Level::debug) {
@@ -113,7 +115,7 @@ class Surface : public SurfaceInterface {
     return m_grid.property(cellId, prop);
   }
 
-  void property(const GInt cellId, const CellProperties prop, const GBool value) { m_properties[cellId][static_cast<GInt>(prop)] = value; }
+  void property(const GInt cellId, const CellProperties prop, const GBool value) { (*m_properties)(cellId, prop) = value; }
 
   auto setProperty(const CellProperties prop, const GBool value) {
     for(const GInt surfCellId : m_cellId) {
@@ -127,8 +129,8 @@ class Surface : public SurfaceInterface {
   std::vector<GInt> m_cellId;
 
   std::unordered_map<GInt, VectorD<NDIM>> m_normal;
-  CartesianGridData<NDIM>                 m_grid;
-  grid::cell::BitsetType*                 m_properties = nullptr;
+  CartesianGridData<NDIM, LAYOUT>         m_grid;
+  PropertyStorageType*                    m_properties = nullptr;
 
   GBool m_hasBndryGhosts = false;
 };
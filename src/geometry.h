@@ -19,6 +19,27 @@ using json = nlohmann::json;
 // todo: move to boundary condition
 enum class BoundaryConditionType { Wall };
 
+/// Features of the surface cutting a cell, which are used for the feature-based refinement.
+struct SurfaceFeatures {
+  // largest angle between the normals of the elements and their mean normal
+  GDouble normalAngle = 0;
+  // largest angle between one of the elements and its neighbors
+  GDouble dihedralAngle = 0;
+  // smallest radius of curvature of the elements
+  GDouble featureSize = std::numeric_limits<GDouble>::max();
+};
+
+/// Features of a single element of a geometry, which are determined once the geometry is loaded.
+template <GInt NDIM>
+struct ElementFeatures {
+  // unit normal of the element
+  VectorD<NDIM> normal;
+  // largest angle between the normal of the element and the normals of the elements sharing an edge
+  GDouble dihedralAngle = 0;
+  // radius of curvature estimated from the angle and the distance to the elements sharing an edge
+  GDouble featureSize = std::numeric_limits<GDouble>::max();
+};
+
 class GeometryInterface {
  public:
   GeometryInterface(const MPI_Comm comm) : m_comm(comm){};
@@ -36,6 +57,15 @@ class GeometryInterface {
   [[nodiscard]] virtual auto inline noElements() const -> GInt                                                      = 0;
   [[nodiscard]] virtual auto inline noElements(GInt objId) const -> GInt                                            = 0;
 
+  /// Check if a cell is cut by one of the candidate elements (nullptr to check all elements).
+  virtual inline auto cutWithCell(const GDouble* cellCenter, const GDouble cellLength, const GInt* candidates,
+                                  const GInt noCandidates) const -> GBool = 0;
+  /// Append the candidate elements (nullptr for all elements) which cut a cell in ascending order.
+  virtual inline void cutElements(const GDouble* cellCenter, const GDouble cellLength, const GInt* candidates, const GInt noCandidates,
+                                  std::vector<GInt>& elements) const = 0;
+  /// Features of the surface given by the elements (in ascending order) cutting a cell.
+  [[nodiscard]] virtual inline auto surfaceFeatures(const GInt* elements, const GInt noElements) const -> SurfaceFeatures = 0;
+
  private:
   MPI_Comm m_comm;
 };
@@ -54,6 +84,20 @@ class GeometryRepresentation {
 
   [[nodiscard]] virtual inline auto pointIsInside(const Point<NDIM>& x) const -> GBool                        = 0;
   [[nodiscard]] virtual inline auto cutWithCell(const Point<NDIM>& center, GDouble cellLength) const -> GBool = 0;
+  /// Determine the elements of the geometry which cut a cell.
+  /// \param center Center of the cell.
+  /// \param cellLength Length of the cell.
+  /// \param candidates Elements (global ids in ascending order) that are checked or nullptr to check all elements.
+  /// \param noCandidates Number of candidates.
+  /// \param elements The global ids of the elements cutting the cell are appended.
+  /// \param firstOnly Stop after the first element that cuts the cell.
+  virtual inline void cutElements(const Point<NDIM>& center, GDouble cellLength, const GInt* candidates, GInt noCandidates,
+                                  std::vector<GInt>& elements, GBool firstOnly) const = 0;
+  /// Features of an element of the geometry.
+  /// \param elementId Global id of the element.
+  /// \param features Features of the element.
+  /// \return The geometry provides the features, i.e., its surface is given by elements (e.g. not analytical).
+  virtual inline auto elementFeatures(GInt elementId, ElementFeatures<NDIM>& features) const -> GBool = 0;
   [[nodiscard]] virtual inline auto getBoundingBox() const -> BoundingBoxDynamic                              = 0;
   [[nodiscard]] virtual inline auto str() const -> GString                                                    = 0;
   [[nodiscard]] virtual inline auto noElements() const -> GInt                                                = 0;
@@ -208,128 +252,64 @@ class GeometrySTL : public GeometryRepresentation<DEBUG_LEVEL, NDIM> {
   }
 
   [[nodiscard]] inline auto cutWithCell(const Point<NDIM>& cellCenter, const GDouble cellLength) const -> GBool override {
-    if(cellCutWithObjBB(cellCenter, cellLength)) {
-      std::vector<GInt>             nodeList;
-      std::array<GDouble, 2 * NDIM> targetRegion;
-      for(GInt dir = 0; dir < NDIM; ++dir) {
-        // search for cuts within the bb of the current cell
-        targetRegion[2 * dir]     = cellCenter[dir] - HALF * cellLength;
-        targetRegion[2 * dir + 1] = cellCenter[dir] + HALF * cellLength;
-      }
+    std::vector<GInt> elements;
+    cutElements(cellCenter, cellLength, nullptr, 0, elements, true);
+    return !elements.empty();
+  }
 
+  inline void cutElements(const Point<NDIM>& cellCenter, const GDouble cellLength, const GInt* candidates, const GInt noCandidates,
+                          std::vector<GInt>& elements, const GBool firstOnly) const override {
+    if(!cellCutWithObjBB(cellCenter, cellLength)) {
+      return;
+    }
+    std::vector<GInt>             nodeList;
+    std::array<GDouble, 2 * NDIM> targetRegion;
+    for(GInt dir = 0; dir < NDIM; ++dir) {
+      // search for cuts within the bb of the current cell
+      targetRegion[2 * dir]     = cellCenter[dir] - HALF * cellLength;
+      targetRegion[2 * dir + 1] = cellCenter[dir] + HALF * cellLength;
+    }
+
+    if(candidates == nullptr) {
       // obtain kd tree nodes which have possible cuts
       m_kd.retrieveNodes(targetRegion, nodeList);
-      if(DEBUG_LEVEL > Debug_Level::debug) {
-        if(!nodeList.empty()) {
-          logger << "possible nodes " << strStreamify(nodeList).str() << std::endl;
-        } else {
-          logger << "no nodes!" << std::endl;
-        }
-      }
-      removeNonOverlappingNodes(targetRegion, nodeList);
-
-      if(DEBUG_LEVEL > Debug_Level::debug) {
-        if(!nodeList.empty()) {
-          logger << "possible nodes after non-overlapping removal " << strStreamify(nodeList).str() << std::endl;
-        } else {
-          logger << "no nodes left after non-overlapping removal!" << std::endl;
-        }
+    } else {
+      // only the triangles cutting the parent cell can cut the cell
+      nodeList.resize(noCandidates);
+      std::transform(candidates, candidates + noCandidates, nodeList.begin(),
+                     [&](const GInt elementId) { return elementId - elementOffset(); });
+    }
+    if(DEBUG_LEVEL > Debug_Level::debug) {
+      if(!nodeList.empty()) {
+        logger << "possible nodes " << strStreamify(nodeList).str() << std::endl;
+      } else {
+        logger << "no nodes!" << std::endl;
       }
+    }
+    removeNonOverlappingNodes(targetRegion, nodeList);
 
+    if(DEBUG_LEVEL > Debug_Level::debug) {
       if(!nodeList.empty()) {
-        static constexpr GInt combo[3][6]    = {{0, 2, 0, 2, 1, 2}, {0, 2, 0, 2, 0, 1}, {0, 1, 0, 1, 1, 2}};
-        const GDouble         cellHalfLength = HALF * cellLength;
-        for(const GInt triId : nodeList) {
-          GBool                            cut  = true;
-          auto&                            tri  = m_triangles[triId];
-          const std::array<Point<NDIM>, 3> vert = {tri.m_vertices[0] - cellCenter, tri.m_vertices[1] - cellCenter,
-                                                   tri.m_vertices[2] - cellCenter};
-          //          const Point<NDIM>                res  = vert[1] - vert[0];
-          const std::array<Point<NDIM>, 3> edge = {vert[1] - vert[0], vert[2] - vert[1], vert[0] - vert[2]};
-
-
-          for(GInt i = 0; i < 3; ++i) {
-            GInt mul = 1;
-            GInt j   = 2;
-            GInt k   = 1;
-            for(GInt l = 0; l < NDIM; ++l) {
-              GDouble p0 = mul * edge[i][j] * vert[combo[i][2 * l]][k] - mul * edge[i][k] * vert[combo[i][2 * l]][j];
-              GDouble p1 = mul * edge[i][j] * vert[combo[i][2 * l + 1]][k] - mul * edge[i][k] * vert[combo[i][2 * l + 1]][j];
-
-              const GDouble min = (p0 < p1) ? p0 : p1;
-              const GDouble max = (p0 < p1) ? p1 : p0;
-              const GDouble rad = cellHalfLength * (abs(edge[i][j]) + abs(edge[i][k]));
-
-              if(min > rad || max < -rad) {
-                cut = false;
-                break;
-              }
-
-              mul *= -1;
-              j -= l;
-              k = 0;
-            }
-            if(!cut) {
-              break;
-            }
-          }
-          if(!cut) {
-            continue;
-          }
-
-          for(GInt i = 0; i < NDIM; i++) {
-            GDouble min = vert[0][i];
-            GDouble max = vert[0][i];
-
-            for(GInt j = 1; j < NDIM; j++) {
-              if(vert[j][i] < min) {
-                min = vert[j][i];
-              }
-              if(vert[j][i] > max) {
-                max = vert[j][i];
-              }
-            }
-
-            if(min > cellHalfLength || max < -cellHalfLength) {
-              cut = false;
-              break;
-            }
-          }
-          if(!cut) {
-            continue;
-          }
-          Point<NDIM> normal;
-          // todo: fix for 1D/2D
-          normal[0] = edge[0][1] * edge[1][2] - edge[0][2] * edge[1][1];
-          normal[1] = edge[0][2] * edge[1][0] - edge[0][0] * edge[1][2];
-          normal[2] = edge[0][0] * edge[1][1] - edge[0][1] * edge[1][0];
-
-          GDouble d = normal.dot(vert[0]);
-          d *= -1;
-
-          Point<NDIM> vmin;
-          Point<NDIM> vmax;
-          for(GInt i = 0; i < NDIM; i++) {
-            if(normal[i] > 0.0) {
-              vmin[i] = -cellHalfLength;
-              vmax[i] = cellHalfLength;
-            } else {
-              vmin[i] = cellHalfLength;
-              vmax[i] = -cellHalfLength;
-            }
-          }
+        logger << "possible nodes after non-overlapping removal " << strStreamify(nodeList).str() << std::endl;
+      } else {
+        logger << "no nodes left after non-overlapping removal!" << std::endl;
+      }
+    }
 
-          if((normal[0] * vmin[0] + normal[1] * vmin[1] + normal[2] * vmin[2]) + d > 0.0) {
-            continue;
-          }
-          if((normal[0] * vmax[0] + normal[1] * vmax[1] + normal[2] * vmax[2]) + d >= 0.0) {
-            return true;
-          }
+    const GDouble cellHalfLength = HALF * cellLength;
+    for(const GInt triId : nodeList) {
+      if(triangleCutWithCell(m_triangles[triId], cellCenter, cellHalfLength)) {
+        elements.emplace_back(elementOffset() + triId);
+        if(firstOnly) {
+          return;
         }
       }
     }
+  }
 
-    return false;
+  inline auto elementFeatures(const GInt elementId, ElementFeatures<NDIM>& features) const -> GBool override {
+    features = m_features[elementId - elementOffset()];
+    return true;
   }
 
   [[nodiscard]] inline auto getBoundingBox() const -> BoundingBoxDynamic override { return BoundingBoxDynamic(m_bbox); }
@@ -405,6 +385,7 @@ class GeometrySTL : public GeometryRepresentation<DEBUG_LEVEL, NDIM> {
     }
     determineBoundaryBox();
     m_kd.buildTree(m_triangles, m_bbox);
+    determineFeatures();
   }
 
   void checkFileExistence() {
@@ -598,6 +579,175 @@ class GeometrySTL : public GeometryRepresentation<DEBUG_LEVEL, NDIM> {
     }
   }
 
+  /// Determine the features of the triangles for the feature-based refinement. The triangles sharing an edge are found by
+  /// sorting the vertices, which are identical for neighboring triangles in a valid STL. The radius of curvature between
+  /// two neighbors is estimated by the distance of their centroids and the angle between their normals.
+  void determineFeatures() {
+    m_features.assign(m_noTriangles, ElementFeatures<NDIM>());
+    std::vector<Point<NDIM>> centroids(m_noTriangles);
+    for(GInt triId = 0; triId < m_noTriangles; ++triId) {
+      const auto& tri = m_triangles[triId];
+      centroids[triId] = (tri.m_vertices[0] + tri.m_vertices[1] + tri.m_vertices[2]) / 3.0;
+
+      Point<NDIM> normal = tri.m_normal;
+      if constexpr(NDIM == 3) {
+        // the normal of the file is only used for the orientation, since it might be inaccurate
+        const Point<NDIM> cross = (tri.m_vertices[1] - tri.m_vertices[0]).cross(tri.m_vertices[2] - tri.m_vertices[0]);
+        if(cross.norm() > GDoubleEps) {
+          normal = cross.dot(tri.m_normal) < 0 ? Point<NDIM>(-cross) : cross;
+        }
+      }
+      const GDouble length = normal.norm();
+      m_features[triId].normal = length > GDoubleEps ? Point<NDIM>(normal / length) : Point<NDIM>(Point<NDIM>::Zero());
+    }
+
+    // identical vertices receive the same id
+    const auto lexicographic = [](const Point<NDIM>& a, const Point<NDIM>& b) {
+      return std::lexicographical_compare(a.data(), a.data() + NDIM, b.data(), b.data() + NDIM);
+    };
+    std::vector<GInt> vertexOrder(3 * m_noTriangles);
+    std::iota(vertexOrder.begin(), vertexOrder.end(), 0);
+    const auto vertex = [&](const GInt id) -> const Point<NDIM>& { return m_triangles[id / 3].m_vertices[id % 3]; };
+    std::sort(vertexOrder.begin(), vertexOrder.end(), [&](const GInt a, const GInt b) { return lexicographic(vertex(a), vertex(b)); });
+    std::vector<GInt> vertexIds(3 * m_noTriangles);
+    GInt              noVertices = 0;
+    for(GUint id = 0; id < vertexOrder.size(); ++id) {
+      if(id > 0 && lexicographic(vertex(vertexOrder[id - 1]), vertex(vertexOrder[id]))) {
+        ++noVertices;
+      }
+      vertexIds[vertexOrder[id]] = noVertices;
+    }
+
+    // triangles sharing an edge are adjacent after sorting the edges by their vertices
+    std::vector<std::array<GInt, 3>> edges;
+    edges.reserve(3 * m_noTriangles);
+    for(GInt triId = 0; triId < m_noTriangles; ++triId) {
+      for(GInt vertexId = 0; vertexId < 3; ++vertexId) {
+        const GInt a = vertexIds[3 * triId + vertexId];
+        const GInt b = vertexIds[3 * triId + (vertexId + 1) % 3];
+        edges.push_back({std::min(a, b), std::max(a, b), triId});
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    for(GUint first = 0; first < edges.size();) {
+      GUint last = first + 1;
+      while(last < edges.size() && edges[last][0] == edges[first][0] && edges[last][1] == edges[first][1]) {
+        ++last;
+      }
+      for(GUint idA = first; idA < last; ++idA) {
+        for(GUint idB = idA + 1; idB < last; ++idB) {
+          const GInt    triA     = edges[idA][2];
+          const GInt    triB     = edges[idB][2];
+          const GDouble cosAngle = std::clamp(m_features[triA].normal.dot(m_features[triB].normal), -1.0, 1.0);
+          const GDouble angle    = std::acos(cosAngle);
+          // the chord between the centroids spans the angle on a circle with the radius of curvature
+          const GDouble radius = angle > GDoubleEps ? HALF * (centroids[triA] - centroids[triB]).norm() / std::sin(HALF * angle)
+                                                    : std::numeric_limits<GDouble>::max();
+          for(const GInt triId : {triA, triB}) {
+            m_features[triId].dihedralAngle = std::max(m_features[triId].dihedralAngle, angle);
+            m_features[triId].featureSize   = std::min(m_features[triId].featureSize, radius);
+          }
+        }
+      }
+      first = last;
+    }
+  }
+
+  /// Check if a triangle cuts a cell by testing the separating axes of the triangle and the cell (3D only).
+  /// \param tri Triangle to be checked.
+  /// \param cellCenter Center of the cell.
+  /// \param cellHalfLength Half of the length of the cell.
+  /// \return The triangle cuts the cell.
+  static inline auto triangleCutWithCell(const triangle<NDIM>& tri, const Point<NDIM>& cellCenter, const GDouble cellHalfLength) -> GBool {
+    if constexpr(NDIM != 3) {
+      TERMM(-1, "not implemented");
+    } else {
+      static constexpr GInt            combo[3][6] = {{0, 2, 0, 2, 1, 2}, {0, 2, 0, 2, 0, 1}, {0, 1, 0, 1, 1, 2}};
+      GBool                            cut         = true;
+      const std::array<Point<NDIM>, 3> vert        = {tri.m_vertices[0] - cellCenter, tri.m_vertices[1] - cellCenter,
+                                                      tri.m_vertices[2] - cellCenter};
+      //          const Point<NDIM>                res  = vert[1] - vert[0];
+      const std::array<Point<NDIM>, 3> edge = {vert[1] - vert[0], vert[2] - vert[1], vert[0] - vert[2]};
+
+
+      for(GInt i = 0; i < 3; ++i) {
+        GInt mul = 1;
+        GInt j   = 2;
+        GInt k   = 1;
+        for(GInt l = 0; l < NDIM; ++l) {
+          GDouble p0 = mul * edge[i][j] * vert[combo[i][2 * l]][k] - mul * edge[i][k] * vert[combo[i][2 * l]][j];
+          GDouble p1 = mul * edge[i][j] * vert[combo[i][2 * l + 1]][k] - mul * edge[i][k] * vert[combo[i][2 * l + 1]][j];
+
+          const GDouble min = (p0 < p1) ? p0 : p1;
+          const GDouble max = (p0 < p1) ? p1 : p0;
+          const GDouble rad = cellHalfLength * (abs(edge[i][j]) + abs(edge[i][k]));
+
+          if(min > rad || max < -rad) {
+            cut = false;
+            break;
+          }
+
+          mul *= -1;
+          j -= l;
+          k = 0;
+        }
+        if(!cut) {
+          break;
+        }
+      }
+      if(!cut) {
+        return false;
+      }
+
+      for(GInt i = 0; i < NDIM; i++) {
+        GDouble min = vert[0][i];
+        GDouble max = vert[0][i];
+
+        for(GInt j = 1; j < NDIM; j++) {
+          if(vert[j][i] < min) {
+            min = vert[j][i];
+          }
+          if(vert[j][i] > max) {
+            max = vert[j][i];
+          }
+        }
+
+        if(min > cellHalfLength || max < -cellHalfLength) {
+          cut = false;
+          break;
+        }
+      }
+      if(!cut) {
+        return false;
+      }
+      Point<NDIM> normal;
+      normal[0] = edge[0][1] * edge[1][2] - edge[0][2] * edge[1][1];
+      normal[1] = edge[0][2] * edge[1][0] - edge[0][0] * edge[1][2];
+      normal[2] = edge[0][0] * edge[1][1] - edge[0][1] * edge[1][0];
+
+      GDouble d = normal.dot(vert[0]);
+      d *= -1;
+
+      Point<NDIM> vmin;
+      Point<NDIM> vmax;
+      for(GInt i = 0; i < NDIM; i++) {
+        if(normal[i] > 0.0) {
+          vmin[i] = -cellHalfLength;
+          vmax[i] = cellHalfLength;
+        } else {
+          vmin[i] = cellHalfLength;
+          vmax[i] = -cellHalfLength;
+        }
+      }
+
+      if((normal[0] * vmin[0] + normal[1] * vmin[1] + normal[2] * vmin[2]) + d > 0.0) {
+        return false;
+      }
+      return (normal[0] * vmax[0] + normal[1] * vmax[1] + normal[2] * vmax[2]) + d >= 0.0;
+    }
+  }
+
   void removeNonOverlappingNodes(const std::array<GDouble, 2 * NDIM>& targetRegion, std::vector<GInt>& nodeList) const {
     for(auto it = nodeList.begin(); it != nodeList.end();) {
       const auto& tri = m_triangles[*it];
@@ -627,6 +777,8 @@ class GeometrySTL : public GeometryRepresentation<DEBUG_LEVEL, NDIM> {
   BoundingBoxCT<NDIM>         m_bbox;
   std::array<GDouble, NDIM>   m_extend{};
   KDTree<DEBUG_LEVEL, NDIM>   m_kd;
+  // features of each triangle for the feature-based refinement
+  std::vector<ElementFeatures<NDIM>> m_features;
 };
 
 template <Debug_Level DEBUG_LEVEL, GInt NDIM>
@@ -639,6 +791,17 @@ class GeometryAnalytical : public GeometryRepresentation<DEBUG_LEVEL, NDIM> {
   [[nodiscard]] inline auto min(const GInt dir) const -> GDouble override { return this->getBoundingBox().min(dir); }
   [[nodiscard]] inline auto max(const GInt dir) const -> GDouble override { return this->getBoundingBox().max(dir); }
 
+  inline void cutElements(const Point<NDIM>& center, GDouble cellLength, const GInt* candidates, const GInt noCandidates,
+                          std::vector<GInt>& elements, const GBool /*firstOnly*/) const override {
+    // the object itself is the only element
+    if((candidates == nullptr || noCandidates > 0) && this->cutWithCell(center, cellLength)) {
+      elements.emplace_back(this->elementOffset());
+    }
+  }
+
+  // the surface is not given by elements
+  inline auto elementFeatures(const GInt /*elementId*/, ElementFeatures<NDIM>& /*features*/) const -> GBool override { return false; }
+
  private:
 };
 
@@ -922,6 +1085,9 @@ struct MinMaxType {
 template <Debug_Level DEBUG_LEVEL, GInt NDIM>
 class GeometryManager : public GeometryInterface {
  public:
+  // number of objects that can be selected by the bitmask of cutObjects()
+  static constexpr GInt MAX_NO_MASKED_OBJECTS = 64;
+
   GeometryManager(const MPI_Comm comm) : GeometryInterface(comm){};
 
   void setup(const json& geometry) override {
@@ -1062,6 +1228,80 @@ class GeometryManager : public GeometryInterface {
     return false;
   }
 
+  [[nodiscard]] auto inline cutWithCell(const GDouble* cellCenter, const GDouble cellLength, const GInt* candidates,
+                                        const GInt noCandidates) const -> GBool override {
+    std::vector<GInt> elements;
+    cutElements(Point<NDIM>(cellCenter), cellLength, candidates, noCandidates, elements, true);
+    return !elements.empty();
+  }
+
+  void inline cutElements(const GDouble* cellCenter, const GDouble cellLength, const GInt* candidates, const GInt noCandidates,
+                          std::vector<GInt>& elements) const override {
+    cutElements(Point<NDIM>(cellCenter), cellLength, candidates, noCandidates, elements, false);
+  }
+
+  /// Determine the elements of all objects which cut a cell. Since a cell can only be cut by the elements that cut its
+  /// parent, the elements cutting the parent can be used as candidates to avoid the search in the kd-tree.
+  /// \param cellCenter Center of the cell.
+  /// \param cellLength Length of the cell.
+  /// \param candidates Elements (in ascending order) that are checked or nullptr to check all elements.
+  /// \param noCandidates Number of candidates.
+  /// \param elements The elements cutting the cell are appended in ascending order.
+  /// \param firstOnly Stop after the first element that cuts the cell.
+  void inline cutElements(const Point<NDIM>& cellCenter, const GDouble cellLength, const GInt* candidates, const GInt noCandidates,
+                          std::vector<GInt>& elements, const GBool firstOnly) const {
+    const GInt firstElement = static_cast<GInt>(elements.size());
+    for(const auto& obj : m_geomObj) {
+      if(candidates == nullptr) {
+        obj->cutElements(cellCenter, cellLength, nullptr, 0, elements, firstOnly);
+      } else {
+        const GInt* first = std::lower_bound(candidates, candidates + noCandidates, obj->elementOffset());
+        const GInt* last  = std::lower_bound(first, candidates + noCandidates, obj->elementOffset() + obj->noElements());
+        if(first != last) {
+          obj->cutElements(cellCenter, cellLength, first, static_cast<GInt>(last - first), elements, firstOnly);
+        }
+      }
+      if(firstOnly && static_cast<GInt>(elements.size()) > firstElement) {
+        return;
+      }
+    }
+    std::sort(elements.begin() + firstElement, elements.end());
+  }
+
+  /// Features of the surface given by the elements cutting a cell. The normal angle is the largest angle between the
+  /// normals and their mean, i.e., opposite surfaces within the cell result in the maximum angle. Elements without
+  /// features (e.g. of analytical geometries) result in the maximum angles and a vanishing feature size.
+  /// \param elements Elements cutting the cell (in ascending order).
+  /// \param noElements Number of elements.
+  /// \return Features of the surface.
+  [[nodiscard]] auto inline surfaceFeatures(const GInt* elements, const GInt noElements) const -> SurfaceFeatures override {
+    SurfaceFeatures                    surface;
+    std::vector<ElementFeatures<NDIM>> features(noElements);
+    Point<NDIM>                        meanNormal = Point<NDIM>::Zero();
+    auto                               obj        = m_geomObj.begin();
+    for(GInt id = 0; id < noElements; ++id) {
+      while(elements[id] >= (*obj)->elementOffset() + (*obj)->noElements()) {
+        ++obj;
+      }
+      if(!(*obj)->elementFeatures(elements[id], features[id])) {
+        return SurfaceFeatures{PI, PI, 0};
+      }
+      meanNormal += features[id].normal;
+      surface.dihedralAngle = std::max(surface.dihedralAngle, features[id].dihedralAngle);
+      surface.featureSize   = std::min(surface.featureSize, features[id].featureSize);
+    }
+
+    const GDouble length = meanNormal.norm();
+    if(noElements > 0 && length < GDoubleEps) {
+      surface.normalAngle = PI;
+      return surface;
+    }
+    for(const auto& element : features) {
+      surface.normalAngle = std::max(surface.normalAngle, std::acos(std::clamp(element.normal.dot(meanNormal) / length, -1.0, 1.0)));
+    }
+    return surface;
+  }
+
   [[nodiscard]] auto inline cutWithCell(const GString& geomName, const Point<NDIM>& cellCenter, const GDouble cellLength) const -> GBool {
     // \todo: check overall bounding box first
     for(const auto& obj : m_geomObj) {
@@ -1074,6 +1314,36 @@ class GeometryManager : public GeometryInterface {
     return false;
   }
 
+  /// Index of the geometry object with the given name, e.g. to select the objects of cutObjects().
+  /// \param geomName Name of the geometry object.
+  /// \return Index of the object or -1 if there is no object with this name.
+  [[nodiscard]] auto inline objectId(const GString& geomName) const -> GInt {
+    for(GInt objId = 0; objId < static_cast<GInt>(m_geomObj.size()); ++objId) {
+      if(m_geomObj[objId]->cname() == geomName) {
+        return objId;
+      }
+    }
+    return -1;
+  }
+
+  /// Determine which of the selected geometry objects cut a cell with a single query instead of calling
+  /// cutWithCell(geomName, ...) for each object.
+  /// \param cellCenter Center of the cell.
+  /// \param cellLength Length of the cell.
+  /// \param objects Bitmask of the objects that are checked (bit i corresponds to objectId() i).
+  /// \return Bitmask of the checked objects cutting the cell.
+  [[nodiscard]] auto inline cutObjects(const Point<NDIM>& cellCenter, const GDouble cellLength, const std::uint64_t objects) const
+      -> std::uint64_t {
+    std::uint64_t cut = 0;
+    for(GInt objId = 0; objId < std::min(static_cast<GInt>(m_geomObj.size()), MAX_NO_MASKED_OBJECTS); ++objId) {
+      const std::uint64_t bit = std::uint64_t(1) << objId;
+      if((objects & bit) != 0 && m_geomObj[objId]->cutWithCell(cellCenter, cellLength)) {
+        cut |= bit;
+      }
+    }
+    return cut;
+  }
+
   [[nodiscard]] auto inline noObjects() const -> GInt override { return m_geomObj.size(); }
 
   [[nodiscard]] auto inline noElements() const -> GInt override {
@@ -114,19 +114,26 @@ void GridGenerator<DEBUG_LEVEL>::loadConfiguration() {
     logger << "Setting up benchmarking!" << endl;
   }
 
-  // 2. communicate configuration file to all other processes
-  if(!MPI::isSerial()) {
-    TERMM(-1, "Not implemented!");
-  }
+  // 2. the configuration file has been communicated to all other processes by Configuration::load()
 
   // 3. load&check configuration values
+  // only predict the number of cells and the required memory
+  m_dryRun = opt_config_value<GBool>("dry-run", m_dryRun);
+
   if(!m_benchmark) {
-    m_dim        = required_config_value<GInt>("dim");
-    m_maxNoCells = required_config_value<GInt>("maxNoCells");
+    m_dim = required_config_value<GInt>("dim");
+    // let the storage grow on demand, maxNoCells is then an optional upper limit
+    m_growableMemory = opt_config_value<GBool>("growableMemory", m_growableMemory);
+    if(m_growableMemory || m_dryRun) {
+      m_maxNoCells = opt_config_value<GInt>("maxNoCells", m_maxNoCells);
+    } else {
+      m_maxNoCells = required_config_value<GInt>("maxNoCells");
+    }
   }
 
-  // todo: unused
-  m_dryRun = opt_config_value<GBool>("dry-run", m_dryRun);
+  // request transparent huge pages for the cell data
+  m_hugePages = opt_config_value<GBool>("hugePages", m_hugePages);
+  memory::setHugePageHint(m_hugePages);
 
   m_outputDir = getCWD() + "/" + opt_config_value<GString>("outputDir", m_outputDir);
   if(!isPath(m_outputDir, true)) {
@@ -157,31 +164,48 @@ void GridGenerator<DEBUG_LEVEL>::generateGrid() {
 
 
   cout << SP1 << "Reading Grid definition" << endl;
-  m_grid = std::make_unique<CartesianGridGen<DEBUG_LEVEL, NDIM>>(m_maxNoCells);
+  if(m_dryRun) {
+    // no cells are stored for the prediction
+    m_grid = std::make_unique<CartesianGridGen<DEBUG_LEVEL, NDIM>>(1);
+  } else if(m_growableMemory) {
+    // start with the root cell and its children, the capacity grows with the grid
+    m_grid = std::make_unique<CartesianGridGen<DEBUG_LEVEL, NDIM>>(1 + cartesian::maxNoChildren<NDIM>());
+    gridGen<NDIM>().setGrowable(m_maxNoCells);
+  } else {
+    m_grid = std::make_unique<CartesianGridGen<DEBUG_LEVEL, NDIM>>(m_maxNoCells);
+  }
   if(!m_benchmark) {
     loadGridDefinition<NDIM>();
   } else {
     benchmarkSetup<NDIM>();
   }
-  logger << SP2 << "+ maximum number of cells: " << m_maxNoCells << endl;
-  cout << SP2 << "+ maximum number of cells: " << m_maxNoCells << endl;
+  // the prediction of the dry run reports the required memory instead
+  if(!m_dryRun) {
+    if(m_growableMemory) {
+      const GString limit = m_maxNoCells >= 0 ? std::to_string(m_maxNoCells) : "unlimited";
+      logger << SP2 << "+ maximum number of cells: " << limit << " (growing on demand)" << endl;
+      cout << SP2 << "+ maximum number of cells: " << limit << " (growing on demand)" << endl;
+    } else {
+      logger << SP2 << "+ maximum number of cells: " << m_maxNoCells << endl;
+      cout << SP2 << "+ maximum number of cells: " << m_maxNoCells << endl;
+    }
 
-  // todo: add function to define memory to be allocated
-  // todo: add function to convert to appropriate memory size
-  const GDouble memoryConsumptionKB = CartesianGridGen<DEBUG_LEVEL, NDIM>::memorySizePerCell() * m_maxNoCells / DKBIT;
+    // todo: add function to define memory to be allocated
+    // todo: add function to convert to appropriate memory size
+    const GDouble memoryConsumptionKB = CartesianGridGen<DEBUG_LEVEL, NDIM>::memorySizePerCell() * gridGen<NDIM>().capacity() / DKBIT;
 
-  logger << SP2 << "+ local memory allocated: " << memoryConsumptionKB << "KB" << std::endl;
-  cout << SP2 << "+ local memory allocated: " << memoryConsumptionKB << "KB" << std::endl;
+    logger << SP2 << "+ local memory allocated: " << memoryConsumptionKB << "KB" << std::endl;
+    cout << SP2 << "+ local memory allocated: " << memoryConsumptionKB << "KB" << std::endl;
 
-  if(!MPI::isSerial()) {
-    const GDouble globalMemory = memoryConsumptionKB * static_cast<GDouble>(MPI::globalNoDomains());
-    logger << SP2 << "+ global memory allocated: " << globalMemory << "KB" << std::endl;
-    cout << SP2 << "+ global memory allocated: " << globalMemory << "KB" << std::endl;
+    if(!MPI::isSerial()) {
+      const GDouble globalMemory = memoryConsumptionKB * static_cast<GDouble>(MPI::globalNoDomains());
+      logger << SP2 << "+ global memory allocated: " << globalMemory << "KB" << std::endl;
+      cout << SP2 << "+ global memory allocated: " << globalMemory << "KB" << std::endl;
+    }
   }
 
   m_grid->setMaxLvl(m_maxRefinementLvl);
-  // todo: allow setting the weighting method
-  m_weightMethod = std::make_unique<WeightUniform>();
+  m_weightMethod = weightMethodFactory(m_weightConfig, m_partitionLvl);
 
 
   logger << "\n";
@@ -191,23 +215,44 @@ void GridGenerator<DEBUG_LEVEL>::generateGrid() {
   logger << SP2 << "+ bounding box: " << m_grid->boundingBox().str() << endl;
   RECORD_TIMER_STOP(TimeKeeper[Timers::GridInit]);
 
+  if(m_dryRun) {
+    predictGrid<NDIM>();
+    RECORD_TIMER_STOP(TimeKeeper[Timers::GridGeneration]);
+    return;
+  }
+
   const std::function<GString()> strHighestLvl = [&]() { return to_string(m_grid->currentHighestLvl()); };
   logger.addAttribute({"level", strHighestLvl});
 
   // create partitioning grid first, which is done without MPI parallelization
   gridGen<NDIM>().createPartitioningGrid(m_partitionLvl);
+  // each rank continues with its part of the partitioning grid
+  gridGen<NDIM>().distributePartitioningGrid();
 
-  if(!MPI::isSerial()) {
-    // todo:implement
-    TERMM(-1, "Not implemented");
-    // m_grid->setupMPIComm();
+  gridGen<NDIM>().uniformRefineGrid(m_uniformLvl);
+
+  std::vector<std::unique_ptr<RefinementRegion<NDIM>>> regions;
+  for(const auto& region : m_regionConfig) {
+    regions.emplace_back(refinementRegionFactory<NDIM>(region));
   }
 
-  gridGen<NDIM>().uniformRefineGrid(m_uniformLvl);
+  gridGen<NDIM>().setFeatureRefinement(m_featureRefinement);
+  // compiled for each thread, since the evaluation is not thread-safe
+  std::unique_ptr<ThreadMathExpression<NDIM>> rfnCriterion;
+  if(!m_rfnCriterion.empty()) {
+    rfnCriterion = std::make_unique<ThreadMathExpression<NDIM>>(m_rfnCriterion, std::vector<GString>{"level"});
+  }
 
   RECORD_TIMER_START(TimeKeeper[Timers::GridRefinement]);
   for(GInt refinedLvl = m_uniformLvl; refinedLvl < m_maxRefinementLvl; ++refinedLvl) {
-    GInt noCellsToRefine = gridGen<NDIM>().markBndryCells();
+    GInt noCellsToRefine = gridGen<NDIM>().markBndryCells(m_rfnDistance[refinedLvl]);
+    noCellsToRefine += gridGen<NDIM>().markRegionCells(regions);
+    if(rfnCriterion) {
+      noCellsToRefine += gridGen<NDIM>().markCriterionCells(*rfnCriterion);
+    }
+    if(m_levelBalance) {
+      gridGen<NDIM>().balanceLevels();
+    }
     gridGen<NDIM>().refineMarkedCells(noCellsToRefine);
     logger.updateAttributes();
   }
@@ -216,11 +261,26 @@ void GridGenerator<DEBUG_LEVEL>::generateGrid() {
   // don't output level anymore as a xml attribute
   logger.eraseAttribute("level");
 
+  if(m_growableMemory) {
+    const GDouble finalMemoryKB = CartesianGridGen<DEBUG_LEVEL, NDIM>::memorySizePerCell() * gridGen<NDIM>().capacity() / DKBIT;
+    logger << SP2 << "+ local memory allocated: " << finalMemoryKB << "KB (" << gridGen<NDIM>().capacity() << " cells)" << std::endl;
+    cout << SP2 << "+ local memory allocated: " << finalMemoryKB << "KB (" << gridGen<NDIM>().capacity() << " cells)" << std::endl;
+  }
+
   // todo: add check that we have only
   if(m_alignWithSurface) {
     gridGen<NDIM>().transformMaxRfnmtLvlToExtent(opt_config_value<GInt>("alignDir", 1));
   }
 
+  // cut the Hilbert curve into domains of equal workload
+  gridGen<NDIM>().partitionGrid(*m_weightMethod, m_maxNoOffsprings, m_maxOffspringWorkload, m_noPartitionDomains);
+
+  // store each cell followed by its subtree along the Hilbert curve
+  if(m_depthFirstOrder) {
+    gridGen<NDIM>().reorderDepthFirstHilbert();
+  }
+  gridGen<NDIM>().setGlobalIds();
+
   RECORD_TIMER_START(TimeKeeper[Timers::IO]);
   RECORD_TIMER_START(TimeKeeper[Timers::GridIo]);
   m_grid->save(m_outputDir + m_outGridFilename, m_gridOutConfig);
@@ -249,11 +309,67 @@ void GridGenerator<DEBUG_LEVEL>::loadGridDefinition() {
     TERMM(-1, "Invalid definition of grid level uniformLevel >= maxRfnmtLvl");
   }
 
-  // todo: unused
-  m_maxNoOffsprings = opt_config_value<GInt>("maxNoOffsprings", m_maxNoOffsprings);
+  // width of the band of cells around the boundary which is refined, either for all levels or for each level
+  m_rfnDistance.assign(m_maxRefinementLvl + 1, 0);
+  if(has_config_value("refinementDistance")) {
+    const json rfnDistance = required_config_value<json>("refinementDistance");
+    if(rfnDistance.is_array()) {
+      for(GUint lvl = 0; lvl < std::min(rfnDistance.size(), m_rfnDistance.size()); ++lvl) {
+        m_rfnDistance[lvl] = rfnDistance[lvl].get<GInt>();
+      }
+    } else {
+      std::fill(m_rfnDistance.begin(), m_rfnDistance.end(), rfnDistance.get<GInt>());
+    }
+  }
+
+  // regions in which the cells are refined up to a given level
+  m_regionConfig = opt_config_value<json>("refinementRegions", m_regionConfig);
+  if(!m_regionConfig.is_array()) {
+    TERMM(-1, "The refinement regions need to be given as an array!");
+  }
+  for(const auto& region : m_regionConfig) {
+    const GInt regionLvl = config::required_config_value<GInt>(region, "level");
+    if(regionLvl > m_maxRefinementLvl) {
+      TERMM(-1, "Invalid level of a refinement region " + std::to_string(regionLvl) + " > maxRfnmtLvl");
+    }
+  }
+
+  // cells are refined where the expression of the cell center and the level is positive, e.g. "level < 6 and x < 0"
+  m_rfnCriterion = opt_config_value<GString>("refinementCriterion", m_rfnCriterion);
+
+  // refine the boundary cells from the minimum level on only where the surface features are not resolved
+  if(has_config_value("featureRefinement")) {
+    const json    features     = required_config_value<json>("featureRefinement");
+    const GDouble degreeToRad  = PI / 180.0;
+    m_featureRefinement.minLvl = config::required_config_value<GInt>(features, "minLevel");
+    m_featureRefinement.normalAngle =
+        degreeToRad * config::opt_config_value<GDouble>(features, "normalAngle", DEFAULT_FEATURE_NORMALANGLE);
+    m_featureRefinement.dihedralAngle =
+        degreeToRad * config::opt_config_value<GDouble>(features, "dihedralAngle", DEFAULT_FEATURE_DIHEDRALANGLE);
+    m_featureRefinement.cellsPerFeature = config::opt_config_value<GDouble>(features, "cellsPerFeature", DEFAULT_CELLSPERFEATURE);
+    if(m_featureRefinement.minLvl < m_uniformLvl) {
+      TERMM(-1, "Invalid definition of the feature refinement minLevel < uniformLevel");
+    }
+  }
+
+  // refine leaf cells such that the levels of neighboring leaf cells differ by at most one
+  m_levelBalance = opt_config_value<GBool>("levelBalance", m_levelBalance);
+
+  // limits of the subtree of a partition cell and the workload of the cells for the partitioning
+  m_maxNoOffsprings      = opt_config_value<GInt>("maxNoOffsprings", m_maxNoOffsprings);
+  m_maxOffspringWorkload = opt_config_value<GDouble>("maxOffspringWorkload", m_maxOffspringWorkload);
+  m_weightConfig         = opt_config_value<json>("weightMethod", m_weightConfig);
+  // number of domains of the partitioned grid
+  m_noPartitionDomains = opt_config_value<GInt>("noDomains", MPI::globalNoDomains());
+  if(m_noPartitionDomains < 1) {
+    TERMM(-1, "Invalid number of domains " + std::to_string(m_noPartitionDomains));
+  }
 
   m_outGridFilename = opt_config_value<GString>("gridFileName", m_outGridFilename);
 
+  // order the final grid depth-first along the Hilbert curve instead of level by level
+  m_depthFirstOrder = opt_config_value<GBool>("depthFirstOrder", m_depthFirstOrder);
+
   json defaultGridOutConfig = {{"format", "ASCII"}, {"cellFilter", "highestLvl"}, {"type", "points"}};
   m_gridOutConfig           = opt_config_value<json>("output", defaultGridOutConfig);
 
@@ -285,6 +401,83 @@ void GridGenerator<DEBUG_LEVEL>::loadGridDefinition() {
   RECORD_TIMER_STOP(TimeKeeper[Timers::GridIo]);
 }
 
+template <Debug_Level DEBUG_LEVEL>
+template <GInt NDIM>
+void GridGenerator<DEBUG_LEVEL>::predictGrid() {
+  logger << SP1 << "Dry run: predicting the grid without generating it" << endl;
+  cout << SP1 << "Dry run: predicting the grid without generating it" << endl;
+
+  const GridPrediction prediction = gridGen<NDIM>().predictGrid(m_partitionLvl, m_uniformLvl);
+  for(GInt lvl = m_partitionLvl; lvl <= m_maxRefinementLvl; ++lvl) {
+    logger << SP2 << "+ level " << lvl << ": " << prediction.noCells[lvl] << " cells (" << prediction.noBndryCells[lvl] << " boundary cells)"
+           << endl;
+    cout << SP2 << "+ level " << lvl << ": " << prediction.noCells[lvl] << " cells (" << prediction.noBndryCells[lvl] << " boundary cells)"
+         << endl;
+  }
+  logger << SP2 << "+ number of cells: " << prediction.size << endl;
+  cout << SP2 << "+ number of cells: " << prediction.size << endl;
+
+  // the inside check of each cell can differ from the check of its whole region for geometries with holes or ambiguous
+  // ray intersections, hence, a small safety margin is added
+  static constexpr GDouble safetyFactor      = 1.05;
+  const GInt               recommendedNoCells = static_cast<GInt>(std::ceil(safetyFactor * static_cast<GDouble>(prediction.capacity)));
+  const GDouble            peakMemoryKB       = CartesianGridGen<DEBUG_LEVEL, NDIM>::memorySizePerCell() * prediction.capacity / DKBIT;
+  logger << SP2 << "+ required number of cells: " << prediction.capacity << endl;
+  cout << SP2 << "+ required number of cells: " << prediction.capacity << endl;
+  logger << SP2 << "+ recommended maxNoCells: " << recommendedNoCells << endl;
+  cout << SP2 << "+ recommended maxNoCells: " << recommendedNoCells << endl;
+  logger << SP2 << "+ peak memory: " << peakMemoryKB << "KB" << endl;
+  cout << SP2 << "+ peak memory: " << peakMemoryKB << "KB" << endl;
+  if(m_maxNoCells >= 0 && m_maxNoCells < prediction.capacity) {
+    logger << "WARNING: maxNoCells " << m_maxNoCells << " is not sufficient to generate the grid!" << endl;
+    cerr0 << "WARNING: maxNoCells " << m_maxNoCells << " is not sufficient to generate the grid!" << endl;
+  }
+
+  if(std::any_of(m_rfnDistance.begin(), m_rfnDistance.end(), [](const GInt distance) { return distance > 0; })) {
+    logger << "WARNING: the refinement distance is not considered by the prediction!" << endl;
+    cerr0 << "WARNING: the refinement distance is not considered by the prediction!" << endl;
+  }
+  if(m_featureRefinement.minLvl >= 0) {
+    logger << "WARNING: the feature refinement is not considered by the prediction!" << endl;
+    cerr0 << "WARNING: the feature refinement is not considered by the prediction!" << endl;
+  }
+  if(!m_rfnCriterion.empty()) {
+    logger << "WARNING: the refinement criterion is not considered by the prediction!" << endl;
+    cerr0 << "WARNING: the refinement criterion is not considered by the prediction!" << endl;
+  }
+  if(!m_regionConfig.empty()) {
+    logger << "WARNING: the refinement regions are not considered by the prediction!" << endl;
+    cerr0 << "WARNING: the refinement regions are not considered by the prediction!" << endl;
+  }
+  if(m_levelBalance) {
+    logger << "WARNING: the level balance is not considered by the prediction!" << endl;
+    cerr0 << "WARNING: the level balance is not considered by the prediction!" << endl;
+  }
+
+  // only the cells selected by the cell filter are written (see CartesianGridGen::save())
+  const GString filter        = config::opt_config_value(m_gridOutConfig, "cellFilter", GString("leafCells"));
+  GInt          noOutputCells = prediction.noLeafCells;
+  if(filter == "highestLvl") {
+    noOutputCells = prediction.noCells[m_maxRefinementLvl];
+  } else if(filter == "lowestLvl" || filter == "partitionLvl") {
+    noOutputCells = prediction.noCells[m_partitionLvl];
+  } else if(filter == "targetLvl") {
+    const GInt outputLvl = config::required_config_value<GInt>(m_gridOutConfig, "outputLvl");
+    noOutputCells        = outputLvl >= m_partitionLvl && outputLvl <= m_maxRefinementLvl ? prediction.noCells[outputLvl] : 0;
+  }
+  logger << SP2 << "+ number of output cells (" << filter << "): " << noOutputCells << endl;
+  cout << SP2 << "+ number of output cells (" << filter << "): " << noOutputCells << endl;
+  const GInt noOutputValues = config::opt_config_value(m_gridOutConfig, "outputValues", std::vector<GString>({"level"})).size();
+  const std::array<std::pair<GString, GInt>, 3> outputSize = {
+      {{"ASCII", ASCII::estimatePointsCSVSize<NDIM>(noOutputCells, noOutputValues)},
+       {"VTK", VTK::ASCII::estimatePointsSize<NDIM>(noOutputCells, noOutputValues)},
+       {"VTKB", VTK::BINARY::estimatePointsSize<NDIM>(noOutputCells, noOutputValues)}}};
+  for(const auto& [format, fileSize] : outputSize) {
+    logger << SP2 << "+ estimated output size (" << format << "): " << static_cast<GDouble>(fileSize) / DKBIT << "KB" << endl;
+    cout << SP2 << "+ estimated output size (" << format << "): " << static_cast<GDouble>(fileSize) / DKBIT << "KB" << endl;
+  }
+}
+
 template <Debug_Level DEBUG_LEVEL>
 template <GInt NDIM>
 void GridGenerator<DEBUG_LEVEL>::benchmarkSetup() {
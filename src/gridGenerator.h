@@ -12,6 +12,7 @@
 #include "gridcell_properties.h"
 #include "interface/solver_interface.h"
 #include "loadbalancing_weights.h"
+#include "refinement_regions.h"
 
 using json = nlohmann::json;
 
@@ -32,6 +33,7 @@ class GridGenerator : public Runnable, private Configuration {
   auto run() -> GInt override;
   auto grid() const -> const GridInterface& override { return *m_grid; };
   void transferGrid(const GridInterface& /*grid*/) override { TERMM(-1, "Not implemented!"); };
+  auto releaseGrid() -> std::unique_ptr<GridInterface> override { return std::move(m_grid); };
 
  private:
   int m_domainId  = -1;
@@ -49,6 +51,8 @@ class GridGenerator : public Runnable, private Configuration {
   void benchmarkSetup();
   template <GInt nDim>
   void generateGrid();
+  template <GInt nDim>
+  void predictGrid();
   template <GInt NDIM>
   [[nodiscard]] auto inline gridGen() -> CartesianGridGen<DEBUG_LEVEL, NDIM>& {
     return *static_cast<CartesianGridGen<DEBUG_LEVEL, NDIM>*>(m_grid.get());
@@ -64,15 +68,29 @@ class GridGenerator : public Runnable, private Configuration {
   // maximum size of subtree of a partitioning cell
   GInt m_maxNoOffsprings = DEFAULT_MAXNOOFFSPRINGS;
   // maximum workload of subtree of a partitioning cell
-  GInt                               m_maxOffspringWorkload = DEFAULT_MAXNOOFFSPRINGS;
+  GDouble                            m_maxOffspringWorkload = DEFAULT_MAXOFFSPRINGWORKLOAD;
+  // number of domains of the partitioned grid
+  GInt                               m_noPartitionDomains   = 1;
   GInt                               m_partitionLvl         = -1;
   GInt                               m_uniformLvl           = -1;
   GInt                               m_maxRefinementLvl     = -1;
   GBool                              m_dryRun               = false;
+  GBool                              m_growableMemory       = false;
+  GBool                              m_hugePages            = false;
   GBool                              m_benchmark            = false;
   GBool                              m_alignWithSurface     = false;
+  GBool                              m_depthFirstOrder      = false;
+  GBool                              m_levelBalance         = false;
+  // criterion of the feature-based refinement of the boundary cells
+  FeatureRefinement                  m_featureRefinement{};
+  // width of the band of refined cells around the boundary for each level
+  std::vector<GInt>                  m_rfnDistance{};
+  // expression of the cell center and level, cells with a positive value are refined
+  GString                            m_rfnCriterion{};
   GString                            m_outputDir            = "out";
   GString                            m_outGridFilename      = "grid";
+  json                               m_weightConfig         = {{"type", "uniform"}};
+  json                               m_regionConfig         = json::array();
   std::unique_ptr<WeightMethod>      m_weightMethod;
   std::unique_ptr<GridInterface>     m_grid;
   std::shared_ptr<GeometryInterface> m_geometry;
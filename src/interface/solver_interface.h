@@ -1,6 +1,7 @@
 #ifndef GRIDGENERATOR_APP_INTERFACE_H
 #define GRIDGENERATOR_APP_INTERFACE_H
 
+#include <memory>
 #include "interface/grid_interface.h"
 
 class Runnable {
@@ -14,6 +15,17 @@ class Runnable {
   [[nodiscard]] virtual auto grid() const -> const GridInterface&    = 0;
   virtual void               transferGrid(const GridInterface& grid) = 0;
 
+  /// Take over the grid of another runnable (see releaseGrid()). Runnables supporting it move the cell data instead of
+  /// copying it, e.g., a solver on a CartesianGrid overrides this with CartesianGrid::loadGrid(std::move(grid), config).
+  /// By default the grid is copied and released afterwards, i.e., both grids are held in memory during the copy.
+  /// \param grid Grid to take over.
+  virtual void transferGrid(std::unique_ptr<GridInterface> grid) { transferGrid(*grid); }
+
+  /// Give up the ownership of the grid, e.g., to transfer it to another runnable without copying it. Only valid for
+  /// runnables owning their grid (e.g. the grid generator), the others terminate.
+  /// \return The grid of the runnable.
+  virtual auto releaseGrid() -> std::unique_ptr<GridInterface> { TERMM(-1, "Not implemented!"); }
+
 
   // todo:
   // virtual auto type() -> AppType = 0;
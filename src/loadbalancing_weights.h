@@ -1,11 +1,23 @@
 #ifndef GRIDGENERATOR_LOADBALANCING_WEIGHTS_H
 #define GRIDGENERATOR_LOADBALANCING_WEIGHTS_H
 
-enum class WeightMethodsTypes { uniform };
+#include <cmath>
+#include <json.h>
+#include <memory>
+#include <sfcmm_common.h>
+#include "common/configuration.h"
+#include "gridcell_properties.h"
 
+enum class WeightMethodsTypes { uniform, bndryCells, level };
+
+/// Workload of a cell used for the load balancing.
 class WeightMethod {
  public:
-  virtual auto weight(GInt id) -> GFloat = 0;
+  /// Workload of a cell.
+  /// \param properties Properties of the cell.
+  /// \param level Level of the cell.
+  /// \return Workload of the cell.
+  [[nodiscard]] virtual auto weight(const grid::cell::BitsetType& properties, GInt level) const -> GFloat = 0;
 
   WeightMethod()                                       = default;
   virtual ~WeightMethod()                              = default;
@@ -25,7 +37,66 @@ class WeightUniform : public WeightMethod {
   auto operator=(const WeightUniform&) -> WeightUniform& = delete;
   auto operator=(WeightUniform&&) -> WeightUniform&      = delete;
 
-  auto weight(GInt /*id*/) -> GFloat override { return 1.0; }
+  [[nodiscard]] auto weight(const grid::cell::BitsetType& /*properties*/, GInt /*level*/) const -> GFloat override { return 1.0; }
+};
+
+/// Boundary cells have an increased workload, e.g., due to the boundary conditions.
+class WeightBndryCells : public WeightMethod {
+ public:
+  explicit WeightBndryCells(const GFloat bndryWeight) : m_bndryWeight(bndryWeight) {}
+  ~WeightBndryCells() override                                 = default;
+  WeightBndryCells(const WeightBndryCells&)                    = delete;
+  WeightBndryCells(WeightBndryCells&&)                         = delete;
+  auto operator=(const WeightBndryCells&) -> WeightBndryCells& = delete;
+  auto operator=(WeightBndryCells&&) -> WeightBndryCells&      = delete;
+
+  [[nodiscard]] auto weight(const grid::cell::BitsetType& properties, GInt /*level*/) const -> GFloat override {
+    return properties[grid::cell::p(CellProperties::bndry)] ? m_bndryWeight : 1.0F;
+  }
+
+ private:
+  GFloat m_bndryWeight = 1.0;
 };
 
+/// The workload increases with the level of the cell by a constant factor, e.g., for time stepping with a time step
+/// size depending on the level.
+class WeightLevel : public WeightMethod {
+ public:
+  /// \param levelFactor Factor of the workload between two levels.
+  /// \param baseLvl Level with a workload of 1.
+  WeightLevel(const GFloat levelFactor, const GInt baseLvl) : m_levelFactor(levelFactor), m_baseLvl(baseLvl) {}
+  ~WeightLevel() override                            = default;
+  WeightLevel(const WeightLevel&)                    = delete;
+  WeightLevel(WeightLevel&&)                         = delete;
+  auto operator=(const WeightLevel&) -> WeightLevel& = delete;
+  auto operator=(WeightLevel&&) -> WeightLevel&      = delete;
+
+  [[nodiscard]] auto weight(const grid::cell::BitsetType& /*properties*/, GInt level) const -> GFloat override {
+    return std::pow(m_levelFactor, static_cast<GFloat>(level - m_baseLvl));
+  }
+
+ private:
+  GFloat m_levelFactor = 1.0;
+  GInt   m_baseLvl     = 0;
+};
+
+/// Create the weight method defined by the configuration, e.g., {"type": "bndryCells", "bndryWeight": 2.0} or
+/// {"type": "level", "levelFactor": 2.0}.
+/// \param config Configuration of the weight method.
+/// \param baseLvl Level with a workload of 1 for the level weighting.
+/// \return The weight method.
+inline auto weightMethodFactory(const nlohmann::json& config, const GInt baseLvl) -> std::unique_ptr<WeightMethod> {
+  const GString type = config::opt_config_value<GString>(config, "type", "uniform");
+  if(type == "uniform") {
+    return std::make_unique<WeightUniform>();
+  }
+  if(type == "bndryCells") {
+    return std::make_unique<WeightBndryCells>(config::opt_config_value<GFloat>(config, "bndryWeight", 2.0));
+  }
+  if(type == "level") {
+    return std::make_unique<WeightLevel>(config::opt_config_value<GFloat>(config, "levelFactor", 2.0), baseLvl);
+  }
+  TERMM(-1, "Unknown weight method " + type);
+}
+
 #endif // GRIDGENERATOR_LOADBALANCING_WEIGHTS_H
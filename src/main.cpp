@@ -71,6 +71,14 @@ class AppConfiguration {
     m_app->transferGrid(grid);
   }
 
+  /// Move the grid into the application, i.e., without holding two copies of the grid.
+  void transferGrid(std::unique_ptr<GridInterface> grid, const GInt debug) {
+    init(debug);
+    m_app->transferGrid(std::move(grid));
+  }
+
+  [[nodiscard]] auto releaseGrid() -> std::unique_ptr<GridInterface> { return m_app->releaseGrid(); }
+
   void releaseMemory() { m_app.reset(nullptr); }
 
  private:
@@ -282,8 +290,8 @@ auto main(int argc, GChar** argv) -> int {
   // LBM is run by default when using the solver switch
   if(gridGenRet == 0 && (result.count("solver") > 0 || runLBM)) {
     logger.close();
-    solverRunnerLBM.transferGrid(gridGenRunner.grid(), debug);
-    gridGenRunner.releaseMemory();
+    // the grid is moved into the solver, i.e., it is not held twice in memory (see Runnable::transferGrid())
+    solverRunnerLBM.transferGrid(gridGenRunner.releaseGrid(), debug);
     lbmRet = solverRunnerLBM.run(debug);
   }
 
@@ -0,0 +1,174 @@
+#ifndef GRIDGENERATOR_REFINEMENT_REGIONS_H
+#define GRIDGENERATOR_REFINEMENT_REGIONS_H
+
+#include <json.h>
+#include <memory>
+#include <sfcmm_common.h>
+#include "common/configuration.h"
+
+/// Region of the domain in which all cells are refined up to a target level. The cells intersecting a region are found
+/// top-down, i.e., a region that can prune must intersect every cell containing a part of it, otherwise the subtree is
+/// skipped.
+template <GInt NDIM>
+class RefinementRegion {
+ public:
+  /// \param level Level up to which the cells intersecting the region are refined.
+  explicit RefinementRegion(const GInt level) : m_level(level) {}
+  virtual ~RefinementRegion()                                  = default;
+  RefinementRegion(const RefinementRegion&)                    = delete;
+  RefinementRegion(RefinementRegion&&)                         = delete;
+  auto operator=(const RefinementRegion&) -> RefinementRegion& = delete;
+  auto operator=(RefinementRegion&&) -> RefinementRegion&      = delete;
+
+  /// Check if the region intersects the cell. The check may also report cells close to the region.
+  /// \param cellCenter Center of the cell.
+  /// \param cellLength Length of the cell.
+  /// \return The region intersects the cell.
+  [[nodiscard]] virtual auto cutWithCell(const Point<NDIM>& cellCenter, GDouble cellLength) const -> GBool = 0;
+
+  /// Check if the intersection test is reliable for cells of any size, i.e., subtrees of cells not intersecting the
+  /// region can be skipped. Otherwise, the region is only checked for the cells to be marked.
+  [[nodiscard]] virtual auto canPrune() const -> GBool { return true; }
+
+  /// Level up to which the cells intersecting the region are refined.
+  [[nodiscard]] auto level() const -> GInt { return m_level; }
+
+ private:
+  GInt m_level = 0;
+};
+
+/// Axis-aligned box given by two opposite corners.
+template <GInt NDIM>
+class RegionBox : public RefinementRegion<NDIM> {
+ public:
+  RegionBox(const Point<NDIM>& A, const Point<NDIM>& B, const GInt level)
+    : RefinementRegion<NDIM>(level), m_min(A.cwiseMin(B)), m_max(A.cwiseMax(B)) {}
+
+  [[nodiscard]] auto cutWithCell(const Point<NDIM>& cellCenter, const GDouble cellLength) const -> GBool override {
+    const GDouble halfLength = HALF * cellLength;
+    for(GInt dir = 0; dir < NDIM; ++dir) {
+      if(cellCenter[dir] + halfLength < m_min[dir] || cellCenter[dir] - halfLength > m_max[dir]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  Point<NDIM> m_min;
+  Point<NDIM> m_max;
+};
+
+/// Sphere (circle in 2D) given by its center and radius.
+template <GInt NDIM>
+class RegionSphere : public RefinementRegion<NDIM> {
+ public:
+  RegionSphere(const Point<NDIM>& center, const GDouble radius, const GInt level)
+    : RefinementRegion<NDIM>(level), m_center(center), m_radius(radius) {}
+
+  [[nodiscard]] auto cutWithCell(const Point<NDIM>& cellCenter, const GDouble cellLength) const -> GBool override {
+    // distance of the closest point of the cell to the center
+    const GDouble halfLength = HALF * cellLength;
+    GDouble       distance2  = 0;
+    for(GInt dir = 0; dir < NDIM; ++dir) {
+      const GDouble delta = std::max(std::abs(cellCenter[dir] - m_center[dir]) - halfLength, 0.0);
+      distance2 += delta * delta;
+    }
+    return distance2 <= m_radius * m_radius;
+  }
+
+ private:
+  Point<NDIM> m_center;
+  GDouble     m_radius = 0;
+};
+
+/// Cylinder given by the centers A and B of its end faces and its radius (a rectangle in 2D). The cell is approximated by
+/// its circumscribed sphere, i.e., cells slightly outside of the cylinder are reported as well.
+template <GInt NDIM>
+class RegionCylinder : public RefinementRegion<NDIM> {
+ public:
+  RegionCylinder(const Point<NDIM>& A, const Point<NDIM>& B, const GDouble radius, const GInt level)
+    : RefinementRegion<NDIM>(level), m_A(A), m_axis(B - A), m_length(m_axis.norm()), m_radius(radius) {
+    if(m_length <= GDoubleEps) {
+      TERMM(-1, "Invalid cylinder with identical end points");
+    }
+    m_axis /= m_length;
+  }
+
+  [[nodiscard]] auto cutWithCell(const Point<NDIM>& cellCenter, const GDouble cellLength) const -> GBool override {
+    const GDouble     cellRadius = HALF * cellLength * std::sqrt(static_cast<GDouble>(NDIM));
+    const Point<NDIM> x          = cellCenter - m_A;
+    const GDouble     axial      = x.dot(m_axis);
+    if(axial < -cellRadius || axial > m_length + cellRadius) {
+      return false;
+    }
+    return (x - axial * m_axis).norm() <= m_radius + cellRadius;
+  }
+
+ private:
+  Point<NDIM> m_A;
+  Point<NDIM> m_axis;
+  GDouble     m_length = 0;
+  GDouble     m_radius = 0;
+};
+
+/// Region in which the expression of x, y and z is positive, e.g., "x*x + y*y < 0.25". The expression is sampled at the
+/// center and the corners of the cell, hence, it can't prune the coarse cells and parts of the region smaller than a cell
+/// of the current highest level might be missed.
+template <GInt NDIM>
+class RegionExpression : public RefinementRegion<NDIM> {
+ public:
+  RegionExpression(const GString& expression, const GInt level) : RefinementRegion<NDIM>(level), m_expression(expression) {}
+
+  [[nodiscard]] auto cutWithCell(const Point<NDIM>& cellCenter, const GDouble cellLength) const -> GBool override {
+    MathExpression<NDIM>& expression = m_expression.local();
+    if(expression.eval(cellCenter) > 0) {
+      return true;
+    }
+    for(GInt corner = 0; corner < cartesian::maxNoChildren<NDIM>(); ++corner) {
+      Point<NDIM> x;
+      for(GInt dir = 0; dir < NDIM; ++dir) {
+        x[dir] = cellCenter[dir] + HALF * cellLength * cartesian::childDir[corner][dir];
+      }
+      if(expression.eval(x) > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  [[nodiscard]] auto canPrune() const -> GBool override { return false; }
+
+ private:
+  ThreadMathExpression<NDIM> m_expression;
+};
+
+/// Create a refinement region defined by the configuration, e.g., {"type": "box", "A": [0, 0], "B": [1, 1], "level": 6},
+/// {"type": "sphere", "center": [0, 0], "radius": 1, "level": 6}, {"type": "cylinder", "A": [0, 0, 0], "B": [0, 0, 1],
+/// "radius": 1, "level": 6} or {"type": "expression", "expression": "x > y", "level": 6}.
+/// \param config Configuration of the region.
+/// \return The refinement region.
+template <GInt NDIM>
+inline auto refinementRegionFactory(const json& config) -> std::unique_ptr<RefinementRegion<NDIM>> {
+  const GString type  = config::required_config_value<GString>(config, "type");
+  const GInt    level = config::required_config_value<GInt>(config, "level");
+  if(type == "box") {
+    return std::make_unique<RegionBox<NDIM>>(config::required_config_value<NDIM>(config, "A"),
+                                             config::required_config_value<NDIM>(config, "B"), level);
+  }
+  if(type == "sphere") {
+    return std::make_unique<RegionSphere<NDIM>>(config::required_config_value<NDIM>(config, "center"),
+                                                config::required_config_value<GDouble>(config, "radius"), level);
+  }
+  if(type == "cylinder") {
+    return std::make_unique<RegionCylinder<NDIM>>(config::required_config_value<NDIM>(config, "A"),
+                                                  config::required_config_value<NDIM>(config, "B"),
+                                                  config::required_config_value<GDouble>(config, "radius"), level);
+  }
+  if(type == "expression") {
+    return std::make_unique<RegionExpression<NDIM>>(config::required_config_value<GString>(config, "expression"), level);
+  }
+  TERMM(-1, "Unknown refinement region " + type);
+}
+
+#endif // GRIDGENERATOR_REFINEMENT_REGIONS_H